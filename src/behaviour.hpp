@@ -0,0 +1,69 @@
+#pragma once
+#ifndef BEHAVIOUR_HPP
+#define BEHAVIOUR_HPP
+
+#include "components.hpp"
+#include "particle.hpp"
+#include <array>
+#include <cstdint>
+
+/////////////////////////////////////////////////////////////////////////
+/// \enum   Behaviour
+/// \brief  How a particle moves through the grid. Each class has its own
+///         movement kernel, so the kernels never branch on material.
+enum class Behaviour : std::uint8_t {
+    STATIC, ///< Never moves.
+    POWDER, ///< Falls, and topples down either diagonal.
+    LIQUID, ///< Falls and topples like powder, otherwise spreads sideways.
+    GAS,    ///< Rises, and drifts up either diagonal.
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The number of behaviour classes.
+constexpr size_t behaviourCount = static_cast<size_t>(Behaviour::GAS) + 1ULL;
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The behaviour of each material's particles, when they have
+///         gravity.
+constexpr std::array<Behaviour, materialCount> materialBehaviours{
+    Behaviour::POWDER, // NONE
+    Behaviour::POWDER, // CONCRETE
+    Behaviour::POWDER, // SAND
+    Behaviour::LIQUID, // OIL
+    Behaviour::POWDER, // GUNPOWDER
+    Behaviour::LIQUID, // GASOLINE
+    Behaviour::LIQUID, // WATER
+    Behaviour::LIQUID, // ACID
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Find how a particle moves.
+/// \param  particle    the particle to classify.
+/// \return STATIC if it has no gravity, otherwise its material's behaviour.
+[[nodiscard]] inline Behaviour
+behaviourOf(const ParticleComponent& particle) noexcept {
+    return particle.m_useGravity
+               ? materialBehaviours[static_cast<size_t>(particle.m_material)]
+               : Behaviour::STATIC;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Rank behaviours by weight: a heavier class always sinks through
+///         a lighter one, only particles of the same class compare their
+///         densities.
+/// \param  behaviour   the behaviour to rank.
+/// \return the class's weight, STATIC being the heaviest.
+[[nodiscard]] constexpr int weightOf(const Behaviour& behaviour) noexcept {
+    switch (behaviour) {
+    case Behaviour::GAS:
+        return 0;
+    case Behaviour::LIQUID:
+        return 1;
+    case Behaviour::POWDER:
+        return 2;
+    default:
+        return 3;
+    }
+}
+
+#endif // BEHAVIOUR_HPP
@@ -0,0 +1,176 @@
+#pragma once
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Find the index of the lowest set bit.
+/// \param  bits    the bits to search, must not be zero.
+/// \return the index of the lowest set bit.
+inline int countTrailingZeros(const std::uint64_t& bits) noexcept {
+#ifdef _MSC_VER
+    unsigned long index = 0UL;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Visit every set bit of a word, lowest bit first.
+/// \param  bits    the bits to visit.
+/// \param  offset  the column of the word's lowest bit.
+/// \param  func    function taking the column of each set bit.
+template <typename Func>
+void forEachBit(std::uint64_t bits, const int& offset, Func&& func) {
+    while (bits != 0ULL) {
+        const int x = offset + countTrailingZeros(bits);
+        bits &= bits - 1ULL;
+        func(x);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  Bitboard
+/// \brief  A grid of single bits, packed 64 cells per row word.
+///         Mirrors a grid of cells so whole rows and neighbourhoods can be
+///         tested with a handful of bit operations.
+/// \tparam Width   The number of columns.
+/// \tparam Height  The number of rows.
+template <int Width, int Height> class Bitboard {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  The number of 64-bit words per row.
+    static constexpr int WORDS = (Width + 63) / 64;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Clear every bit.
+    void clear() noexcept {
+        for (auto& row : m_rows)
+            row.fill(0ULL);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Set a single cell's bit.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    void set(const int& x, const int& y) noexcept {
+        m_rows[y][x >> 6] |= 1ULL << (x & 63);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Clear a single cell's bit.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    void reset(const int& x, const int& y) noexcept {
+        m_rows[y][x >> 6] &= ~(1ULL << (x & 63));
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Test a single cell's bit.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    /// \return true if the bit is set, false otherwise.
+    [[nodiscard]] bool test(const int& x, const int& y) const noexcept {
+        return ((m_rows[y][x >> 6] >> (x & 63)) & 1ULL) != 0ULL;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve a word of a row.
+    /// \param  y       the row.
+    /// \param  index   the index of the word within the row.
+    /// \return reference to 64 cells of the row.
+    [[nodiscard]] std::uint64_t&
+    word(const int& y, const int& index) noexcept {
+        return m_rows[y][index];
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve a word of a row.
+    /// \param  y       the row.
+    /// \param  index   the index of the word within the row.
+    /// \return reference to 64 cells of the row.
+    [[nodiscard]] const std::uint64_t&
+    word(const int& y, const int& index) const noexcept {
+        return m_rows[y][index];
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Check if a row has no bits set.
+    /// \param  y   the row.
+    /// \return true if every bit of the row is clear, false otherwise.
+    [[nodiscard]] bool rowEmpty(const int& y) const noexcept {
+        std::uint64_t bits = 0ULL;
+        for (const auto& rowWord : m_rows[y])
+            bits |= rowWord;
+        return bits == 0ULL;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Visit every set bit of a row, lowest column first.
+    ///         Each word is read once before visiting its bits, so the
+    ///         function may freely modify the board.
+    /// \param  y       the row.
+    /// \param  func    function taking the column of each set bit.
+    template <typename Func> void forEach(const int& y, Func&& func) const {
+        for (int index = 0; index < WORDS; ++index)
+            forEachBit(m_rows[y][index], index << 6, func);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve a run of up to 57 consecutive bits of a row.
+    /// \param  x       the first column.
+    /// \param  y       the row.
+    /// \param  count   the number of columns.
+    /// \return the bits, the first column in the lowest bit.
+    [[nodiscard]] std::uint64_t
+    extract(const int& x, const int& y, const int& count) const noexcept {
+        const int index = x >> 6;
+        const int offset = x & 63;
+        std::uint64_t bits = m_rows[y][index] >> offset;
+        if (offset + count > 64 && index + 1 < WORDS)
+            bits |= m_rows[y][index + 1] << (64 - offset);
+        return bits & ((1ULL << count) - 1ULL);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the bits of the 8 cells surrounding a cell.
+    ///         Cells outside the board read as clear.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    /// \return the 3x3 neighbourhood, bit ((dy + 1) * 3 + (dx + 1)) holding
+    ///         the cell at offset (dx, dy), with the center bit clear.
+    [[nodiscard]] std::uint32_t
+    neighbours(const int& x, const int& y) const noexcept {
+        const auto window = [&](const int& row) -> std::uint32_t {
+            if (row < 0 || row >= Height)
+                return 0U;
+            if (x == 0)
+                return static_cast<std::uint32_t>(extract(0, row, 2) << 1U);
+            return static_cast<std::uint32_t>(extract(x - 1, row, 3));
+        };
+        return window(y - 1) | ((window(y) & 0b101U) << 3U) |
+               (window(y + 1) << 6U);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the bits of the 8 cells surrounding a cell, without
+    ///         checking the board's edges.
+    /// \param  x   the cell's column, at least 1.
+    /// \param  y   the cell's row, at least 1 and below the last row.
+    /// \return the 3x3 neighbourhood, laid out as in neighbours().
+    [[nodiscard]] std::uint32_t
+    innerNeighbours(const int& x, const int& y) const noexcept {
+        return static_cast<std::uint32_t>(
+            extract(x - 1, y - 1, 3) | ((extract(x - 1, y, 3) & 0b101U) << 3U) |
+            (extract(x - 1, y + 1, 3) << 6U));
+    }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    std::array<std::array<std::uint64_t, WORDS>, Height> m_rows{}; ///< Bits.
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Bitboard marking which cells of the particle array are occupied.
+using OccupancyGrid = Bitboard<513, 513>;
+
+#endif // BITBOARD_HPP
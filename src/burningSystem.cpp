@@ -4,43 +4,42 @@
 /// Custom Constructor
 //////////////////////////////////////////////////////////////////////
 
-BurningSystem::BurningSystem(ecsWorld& gameWorld) : m_gameWorld(gameWorld) {
-    addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
-    addComponentType(
-        FlammableComponent::Runtime_ID, RequirementsFlag::REQUIRED);
-    addComponentType(OnFireComponent::Runtime_ID, RequirementsFlag::REQUIRED);
-}
+BurningSystem::BurningSystem(
+    ecsWorld& gameWorld, TimerWheel<FireTimer>& burnTimers)
+    : m_gameWorld(gameWorld), m_burnTimers(burnTimers) {}
 
 //////////////////////////////////////////////////////////////////////
-/// updateComponents
+/// update
 //////////////////////////////////////////////////////////////////////
 
-void BurningSystem::updateComponents(
-    const double& deltaTime,
-    const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
-    const auto dt = static_cast<float>(deltaTime);
-    std::vector<EntityHandle> entitiesToExtinguish;
-    for (const auto& components : entityComponents) {
-        auto& particleComponent =
-            *static_cast<ParticleComponent*>(components[0]);
-        auto& flammableComponent =
-            *static_cast<FlammableComponent*>(components[1]);
-
-        // Check if this entity has burned up
-        if (flammableComponent.wickTime <= 0.0001F) {
-            particleComponent.m_color = COLOR_SLUDGE;
-            entitiesToExtinguish.emplace_back(
-                flammableComponent.m_entityHandle);
-            continue;
-        }
+void BurningSystem::update() {
+    m_burnTimers.advance([&](const FireTimer& timer) {
+        // Skip entities deleted while burning
+        const auto& handle = timer.handle;
+        const auto entity = m_gameWorld.getEntity(handle);
+        if (!entity)
+            return;
+        const auto particleComponent = static_cast<ParticleComponent*>(
+            m_gameWorld.getComponent<ParticleComponent>(*entity));
+        const auto flammableComponent = static_cast<FlammableComponent*>(
+            m_gameWorld.getComponent<FlammableComponent>(*entity));
+        if (particleComponent == nullptr || flammableComponent == nullptr)
+            return;
+        // Skip entities put out since they were lit
+        if (!timer.isCurrent(*particleComponent))
+            return;
 
-        particleComponent.m_health -= dt;
-        flammableComponent.wickTime -= dt;
-    }
+        // The wick burned out, apply all of its damage at once
+        particleComponent->m_health -= flammableComponent->wickTime;
+        particleComponent->m_color = COLOR_SLUDGE;
 
-    // Extinguish all entities who's wicks burned out
-    for (const auto& handle : entitiesToExtinguish) {
-        m_gameWorld.removeComponent<FlammableComponent>(handle);
-        m_gameWorld.removeComponent<OnFireComponent>(handle);
-    }
-}
\ No newline at end of file
+        // Extinguish the entity
+        particleComponent->m_state &= static_cast<std::uint8_t>(
+            ~(ParticleComponent::FLAMMABLE | ParticleComponent::BURNING));
+        particleComponent->m_state |= ParticleComponent::INERT;
+        if constexpr (!useStateFlags) {
+            m_gameWorld.removeComponent<FlammableComponent>(handle);
+            m_gameWorld.removeComponent<OnFireComponent>(handle);
+        }
+    });
+}
@@ -3,8 +3,8 @@
 #define BURNINGSYSTEM_HPP
 
 #include "components.hpp"
-#include "ecsSystem.hpp"
 #include "ecsWorld.hpp"
+#include "timerWheel.hpp"
 
 ///////////////////////////////////////////////////////////////////////////
 /// Use the shared mini namespace
@@ -12,25 +12,26 @@ using namespace mini;
 
 /////////////////////////////////////////////////////////////////////////
 /// \class  BurningSystem
-/// \brief  System used to lower the health of burning entities.
-class BurningSystem final : public ecsSystem {
+/// \brief  System used to burn-out entities whose wicks have expired.
+///         Only touches entities whose burn-out timer fires this step.
+class BurningSystem final {
     public:
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief  Construct a cleanup system.
+    /// \brief  Construct a burning system.
     /// \param  gameWorld   reference to the engine's game world.
-    explicit BurningSystem(ecsWorld& gameWorld);
+    /// \param  burnTimers  timers scheduled for burning entities.
+    BurningSystem(
+        ecsWorld& gameWorld, TimerWheel<FireTimer>& burnTimers);
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief  Tick this system by deltaTime.
-    /// \param	deltaTime	    the amount of time passed since last update.
-    /// \param	components	    the components to update.
-    void updateComponents(
-        const double&,
-        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
-        final;
+    /// \brief  Tick this system ahead by a single step.
+    void update();
 
     private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
     ecsWorld& m_gameWorld;
+    TimerWheel<FireTimer>& m_burnTimers;
 };
 
-#endif // BURNINGSYSTEM_HPP
\ No newline at end of file
+#endif // BURNINGSYSTEM_HPP
@@ -0,0 +1,496 @@
+#include "checkpoint.hpp"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+//////////////////////////////////////////////////////////////////////
+/// Identifies a checkpoint stream, and the version of its layout
+constexpr char checkpointMagic[4] = { 'P', 'C', 'K', 'P' };
+constexpr std::uint8_t checkpointVersion = 1U;
+//////////////////////////////////////////////////////////////////////
+/// Bytes of the stream's header, of a record's header and of a chunk's
+constexpr size_t streamHeaderSize = 10ULL;
+constexpr size_t recordHeaderSize = 15ULL;
+constexpr size_t chunkHeaderSize = 4ULL;
+//////////////////////////////////////////////////////////////////////
+/// Record kinds
+constexpr std::uint8_t baseRecord = 0U;
+constexpr std::uint8_t deltaRecord = 1U;
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Append a number to a byte buffer, little-endian.
+/// \param  out     the bytes to append to.
+/// \param  value   the number to append.
+/// \param  size    the number of bytes to store it in.
+static void putBytes(
+    std::vector<std::uint8_t>& out, const std::uint64_t& value,
+    const size_t& size) {
+    for (size_t byte = 0ULL; byte < size; ++byte)
+        out.push_back(static_cast<std::uint8_t>(value >> (byte * 8ULL)));
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Overwrite a number stored earlier in a byte buffer.
+/// \param  out     the bytes to write into.
+/// \param  offset  the index of the number's first byte.
+/// \param  value   the number to store.
+/// \param  size    the number of bytes to store it in.
+static void patchBytes(
+    std::vector<std::uint8_t>& out, const size_t& offset,
+    const std::uint64_t& value, const size_t& size) {
+    for (size_t byte = 0ULL; byte < size; ++byte)
+        out[offset + byte] =
+            static_cast<std::uint8_t>(value >> (byte * 8ULL));
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Read a little-endian number out of a byte string.
+/// \param  bytes   the bytes to read from, long enough to hold it.
+/// \param  offset  the index of the number's first byte.
+/// \param  size    the number of bytes it is stored in.
+/// \return the number.
+static std::uint64_t getBytes(
+    const std::string& bytes, const size_t& offset, const size_t& size) {
+    std::uint64_t value = 0ULL;
+    for (size_t byte = 0ULL; byte < size; ++byte)
+        value |= static_cast<std::uint64_t>(
+                     static_cast<unsigned char>(bytes[offset + byte]))
+                 << (byte * 8ULL);
+    return value;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Visit the cells of a chunk in row order.
+/// \param  chunk   the chunk's index, row by row.
+/// \param  func    function taking the index of a run of a row's cells
+///                 within the frame, and the run's length.
+template <typename Func>
+static void forEachChunkRow(const int& chunk, Func&& func) {
+    constexpr int side = CheckpointWriter::SIDE;
+    constexpr int size = CheckpointWriter::CHUNK;
+    const int x = (chunk % CheckpointWriter::CHUNKS) * size;
+    const int y = (chunk / CheckpointWriter::CHUNKS) * size;
+    const auto width = static_cast<size_t>(std::min(size, side - x));
+    const int lastY = std::min(y + size, side);
+    for (int row = y; row < lastY; ++row)
+        func(static_cast<size_t>(row) * side + static_cast<size_t>(x), width);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// Destructor
+//////////////////////////////////////////////////////////////////////
+
+CheckpointWriter::~CheckpointWriter() { close(); }
+
+//////////////////////////////////////////////////////////////////////
+/// open
+//////////////////////////////////////////////////////////////////////
+
+bool CheckpointWriter::open(
+    const std::string& path, const size_t& baseInterval, std::string& error) {
+    if (isOpen()) {
+        error = "a checkpoint stream is already open";
+        return false;
+    }
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        error = "can't create " + path;
+        return false;
+    }
+
+    std::vector<std::uint8_t> header(
+        std::cbegin(checkpointMagic), std::cend(checkpointMagic));
+    putBytes(header, checkpointVersion, 1ULL);
+    putBytes(header, CHUNK, 1ULL);
+    putBytes(header, SIDE, 2ULL);
+    putBytes(header, SIDE, 2ULL);
+    m_file.write(
+        reinterpret_cast<const char*>(header.data()),
+        static_cast<std::streamsize>(header.size()));
+
+    m_baseInterval = std::max<size_t>(baseInterval, 1ULL);
+    m_written = 0ULL;
+    m_stats = Stats();
+    m_stats.bytes = header.size();
+    m_running = true;
+    m_thread = std::thread(&CheckpointWriter::writerLoop, this);
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// close
+//////////////////////////////////////////////////////////////////////
+
+void CheckpointWriter::close() {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_wake.notify_one();
+    if (m_thread.joinable())
+        m_thread.join();
+    if (m_file.is_open())
+        m_file.close();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// beginCheckpoint
+//////////////////////////////////////////////////////////////////////
+
+bool CheckpointWriter::beginCheckpoint() {
+    {
+        // Never wait on the disk, a later delta catches up on this one
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running)
+            return false;
+        if (!m_pending.empty()) {
+            ++m_stats.dropped;
+            return false;
+        }
+        if (m_frame.empty() && !m_freeFrames.empty()) {
+            m_frame = std::move(m_freeFrames.back());
+            m_freeFrames.pop_back();
+        }
+    }
+    m_frame.assign(static_cast<size_t>(SIDE) * SIDE, 0U);
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// submit
+//////////////////////////////////////////////////////////////////////
+
+void CheckpointWriter::submit(const std::uint64_t& step) {
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back({ std::move(m_frame), step });
+        m_frame = std::vector<std::uint8_t>();
+    }
+    m_wake.notify_one();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// getStats
+//////////////////////////////////////////////////////////////////////
+
+CheckpointWriter::Stats CheckpointWriter::getStats() {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// encodeChunks
+//////////////////////////////////////////////////////////////////////
+
+size_t CheckpointWriter::encodeChunks(
+    const std::vector<std::uint8_t>& previous,
+    const std::vector<std::uint8_t>& current, const bool& base,
+    std::vector<std::uint8_t>& out) {
+    size_t count = 0ULL;
+    for (int chunk = 0; chunk < CHUNKS * CHUNKS; ++chunk) {
+        // Settled chunks compare equal a row at a time, and are skipped
+        bool changed = base;
+        forEachChunkRow(chunk, [&](const size_t& index, const size_t& width) {
+            changed = changed || std::memcmp(
+                                     &previous[index], &current[index],
+                                     width) != 0;
+        });
+        if (!changed)
+            continue;
+
+        putBytes(out, static_cast<std::uint64_t>(chunk), 2ULL);
+        const auto lengthOffset = out.size();
+        putBytes(out, 0ULL, 2ULL);
+        std::uint8_t value = current[static_cast<size_t>(
+            (chunk / CHUNKS) * CHUNK * SIDE + (chunk % CHUNKS) * CHUNK)];
+        std::uint8_t run = 0U;
+        forEachChunkRow(chunk, [&](const size_t& index, const size_t& width) {
+            for (size_t cell = index; cell < index + width; ++cell) {
+                if (current[cell] == value && run < 255U) {
+                    ++run;
+                    continue;
+                }
+                out.push_back(run);
+                out.push_back(value);
+                value = current[cell];
+                run = 1U;
+            }
+        });
+        out.push_back(run);
+        out.push_back(value);
+        patchBytes(out, lengthOffset, out.size() - lengthOffset - 2ULL, 2ULL);
+        ++count;
+    }
+    return count;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// writerLoop
+//////////////////////////////////////////////////////////////////////
+
+void CheckpointWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        // Drain every submitted frame before stopping
+        m_wake.wait(lock, [&] { return !m_pending.empty() || !m_running; });
+        if (m_pending.empty())
+            return;
+        auto pending = std::move(m_pending.front());
+        m_pending.pop_front();
+        lock.unlock();
+
+        // Encode the record, patching its counts once known
+        const bool base = m_written % m_baseInterval == 0ULL;
+        m_record.clear();
+        putBytes(m_record, base ? baseRecord : deltaRecord, 1ULL);
+        putBytes(m_record, pending.step, 8ULL);
+        putBytes(m_record, 0ULL, 2ULL);
+        putBytes(m_record, 0ULL, 4ULL);
+        const auto chunks =
+            encodeChunks(m_previous, pending.cells, base, m_record);
+        patchBytes(m_record, 9ULL, chunks, 2ULL);
+        patchBytes(m_record, 11ULL, m_record.size() - recordHeaderSize, 4ULL);
+        m_file.write(
+            reinterpret_cast<const char*>(m_record.data()),
+            static_cast<std::streamsize>(m_record.size()));
+        m_file.flush();
+        const bool failed = !m_file;
+        m_previous.swap(pending.cells);
+        ++m_written;
+
+        lock.lock();
+        if (!pending.cells.empty())
+            m_freeFrames.push_back(std::move(pending.cells));
+        if (base)
+            ++m_stats.bases;
+        else
+            ++m_stats.deltas;
+        m_stats.chunks += chunks;
+        m_stats.bytes += m_record.size();
+        m_stats.failed = m_stats.failed || failed;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \class  CheckpointParser
+/// \brief  Validates and indexes the records of a checkpoint stream.
+class CheckpointParser {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a parser over the bytes of a checkpoint stream.
+    /// \param  bytes   the file's contents.
+    explicit CheckpointParser(const std::string& bytes) : m_bytes(bytes) {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse the stream's header.
+    /// \return true on success, false otherwise.
+    bool parseHeader() {
+        if (m_bytes.size() < streamHeaderSize ||
+            std::memcmp(m_bytes.data(), checkpointMagic, 4ULL) != 0)
+            return fail("not a checkpoint stream");
+        if (getBytes(m_bytes, 4ULL, 1ULL) != checkpointVersion)
+            return fail("unsupported checkpoint version");
+        if (getBytes(m_bytes, 5ULL, 1ULL) != CheckpointWriter::CHUNK ||
+            getBytes(m_bytes, 6ULL, 2ULL) != CheckpointWriter::SIDE ||
+            getBytes(m_bytes, 8ULL, 2ULL) != CheckpointWriter::SIDE)
+            return fail("checkpoint grid doesn't match the simulation's");
+        m_pos = streamHeaderSize;
+        return true;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse the next record's header and check its chunks.
+    /// \param  base        set to true if every chunk is present.
+    /// \param  step        set to the step it was taken at.
+    /// \param  offset      set to the index of its first chunk's bytes.
+    /// \param  chunkCount  set to the number of chunks present.
+    /// \return true if a record was parsed, false at the end of the stream
+    ///         or on failure.
+    bool parseRecord(
+        bool& base, std::uint64_t& step, size_t& offset, size_t& chunkCount) {
+        // A run cut short leaves a partial record, keep what came before it
+        if (m_bytes.size() - m_pos < recordHeaderSize)
+            return false;
+        const auto kind = getBytes(m_bytes, m_pos, 1ULL);
+        step = getBytes(m_bytes, m_pos + 1ULL, 8ULL);
+        chunkCount = getBytes(m_bytes, m_pos + 9ULL, 2ULL);
+        const auto length = getBytes(m_bytes, m_pos + 11ULL, 4ULL);
+        offset = m_pos + recordHeaderSize;
+        if (m_bytes.size() - offset < length)
+            return false;
+
+        base = kind == baseRecord;
+        if (!base && kind != deltaRecord)
+            return fail("unknown checkpoint record");
+        if (!m_seenBase && !base)
+            return fail("checkpoint stream doesn't start with a base");
+        constexpr auto totalChunks = static_cast<size_t>(
+            CheckpointWriter::CHUNKS * CheckpointWriter::CHUNKS);
+        if (base && chunkCount != totalChunks)
+            return fail("checkpoint base is missing chunks");
+        m_seenBase = true;
+        m_pos = offset;
+        for (size_t chunk = 0ULL; chunk < chunkCount; ++chunk)
+            if (!parseChunk(offset + length))
+                return false;
+        if (m_pos != offset + length)
+            return fail("checkpoint record length doesn't match its chunks");
+        return true;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the first problem found.
+    /// \return the problem, empty if none.
+    [[nodiscard]] const std::string& getError() const noexcept {
+        return m_error;
+    }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Check a chunk's runs cover it exactly, with valid materials.
+    /// \param  end the index past the record's last byte.
+    /// \return true on success, false otherwise.
+    bool parseChunk(const size_t& end) {
+        if (end - m_pos < chunkHeaderSize)
+            return fail("truncated checkpoint chunk");
+        const auto chunk = static_cast<int>(getBytes(m_bytes, m_pos, 2ULL));
+        const auto length = getBytes(m_bytes, m_pos + 2ULL, 2ULL);
+        m_pos += chunkHeaderSize;
+        if (chunk >= CheckpointWriter::CHUNKS * CheckpointWriter::CHUNKS)
+            return fail("checkpoint chunk out of range");
+        if (end - m_pos < length || length % 2ULL != 0ULL)
+            return fail("truncated checkpoint chunk");
+
+        size_t cells = 0ULL;
+        forEachChunkRow(chunk, [&](const size_t&, const size_t& width) {
+            cells += width;
+        });
+        size_t covered = 0ULL;
+        for (size_t pair = 0ULL; pair < length; pair += 2ULL) {
+            const auto run = getBytes(m_bytes, m_pos + pair, 1ULL);
+            const auto material = getBytes(m_bytes, m_pos + pair + 1ULL, 1ULL);
+            if (run == 0ULL || material >= materialCount)
+                return fail("invalid checkpoint run");
+            covered += run;
+        }
+        if (covered != cells)
+            return fail("checkpoint runs don't cover their chunk");
+        m_pos += length;
+        return true;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Record a problem with the stream.
+    /// \param  message the problem.
+    /// \return false.
+    bool fail(const std::string& message) {
+        if (m_error.empty())
+            m_error = message;
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    const std::string& m_bytes; ///< The file's contents.
+    size_t m_pos = 0ULL;        ///< Index of the next byte to read.
+    bool m_seenBase = false;    ///< True once a base was parsed.
+    std::string m_error;        ///< The first problem found.
+};
+
+//////////////////////////////////////////////////////////////////////
+/// load
+//////////////////////////////////////////////////////////////////////
+
+std::optional<CheckpointReader>
+CheckpointReader::load(const std::string& path, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "can't open " + path;
+        return {};
+    }
+    std::stringstream bytes;
+    bytes << file.rdbuf();
+
+    CheckpointReader reader;
+    reader.m_bytes = bytes.str();
+    CheckpointParser parser(reader.m_bytes);
+    if (!parser.parseHeader()) {
+        error = parser.getError();
+        return {};
+    }
+    Record record;
+    while (parser.parseRecord(
+        record.base, record.step, record.offset, record.chunkCount))
+        reader.m_records.push_back(record);
+    if (!parser.getError().empty()) {
+        error = parser.getError();
+        return {};
+    }
+    return reader;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// reconstruct
+//////////////////////////////////////////////////////////////////////
+
+std::vector<std::uint8_t>
+CheckpointReader::reconstruct(const size_t& index) const {
+#ifdef DEBUG
+    assert(index < size());
+#endif
+    // The stream opens with a base, so the walk back always finds one
+    size_t base = index;
+    while (!m_records[base].base)
+        --base;
+    std::vector<std::uint8_t> frame(
+        static_cast<size_t>(CheckpointWriter::SIDE) * CheckpointWriter::SIDE,
+        0U);
+    for (size_t record = base; record <= index; ++record)
+        apply(m_records[record], frame);
+    return frame;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// describe
+//////////////////////////////////////////////////////////////////////
+
+std::vector<ParticleDescriptor>
+CheckpointReader::describe(const size_t& index) const {
+    const auto frame = reconstruct(index);
+    std::vector<ParticleDescriptor> descriptors;
+    for (int y = 0; y < CheckpointWriter::SIDE; ++y)
+        for (int x = 0; x < CheckpointWriter::SIDE; ++x) {
+            const auto material = frame[static_cast<size_t>(
+                y * CheckpointWriter::SIDE + x)];
+            if (material != 0U)
+                descriptors.push_back(
+                    { static_cast<Material>(material), x, y });
+        }
+    return descriptors;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// apply
+//////////////////////////////////////////////////////////////////////
+
+void CheckpointReader::apply(
+    const Record& record, std::vector<std::uint8_t>& frame) const {
+    size_t pos = record.offset;
+    for (size_t chunk = 0ULL; chunk < record.chunkCount; ++chunk) {
+        const auto index = static_cast<int>(getBytes(m_bytes, pos, 2ULL));
+        pos += chunkHeaderSize;
+
+        // Runs carry over from one row of the chunk to the next
+        size_t run = 0ULL;
+        std::uint8_t value = 0U;
+        forEachChunkRow(index, [&](const size_t& start, const size_t& width) {
+            for (size_t cell = start; cell < start + width; ++cell) {
+                if (run == 0ULL) {
+                    run = getBytes(m_bytes, pos, 1ULL);
+                    value = static_cast<std::uint8_t>(
+                        getBytes(m_bytes, pos + 1ULL, 1ULL));
+                    pos += 2ULL;
+                }
+                frame[cell] = value;
+                --run;
+            }
+        });
+    }
+}
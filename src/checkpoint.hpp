@@ -0,0 +1,231 @@
+#pragma once
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include "worldBuilder.hpp"
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////
+/// Layout of a checkpoint stream: a header, then one record per checkpoint.
+/// A checkpoint is the material of every grid cell, split into square
+/// chunks. Base records hold every chunk, delta records only the chunks
+/// that changed since the previous record. Each chunk is run-length
+/// encoded as (count, material) byte pairs, in row order. Numbers are
+/// stored little-endian.
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  CheckpointWriter
+/// \brief  Streams checkpoints of the world to a file. The simulation only
+///         fills a frame of cell materials; comparing it against the last
+///         frame, encoding and writing it happen on the writer's own thread.
+///         Frames arriving while the writer is behind are dropped rather
+///         than waited on, the next delta covers their changes.
+class CheckpointWriter {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  The number of cells along each side of a frame.
+    static constexpr int SIDE = 513;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  The number of cells along each side of a chunk.
+    static constexpr int CHUNK = 64;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  The number of chunks along each side of a frame.
+    static constexpr int CHUNKS = (SIDE + CHUNK - 1) / CHUNK;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \struct Stats
+    /// \brief  Counters describing the checkpoints written so far.
+    struct Stats {
+        size_t bases = 0ULL;    ///< Checkpoints written in full.
+        size_t deltas = 0ULL;   ///< Checkpoints written as changed chunks.
+        size_t dropped = 0ULL;  ///< Checkpoints skipped, the writer behind.
+        size_t chunks = 0ULL;   ///< Chunks written overall.
+        size_t bytes = 0ULL;    ///< Bytes written overall.
+        bool failed = false;    ///< True if the file couldn't be written.
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Flush pending checkpoints and stop the writer thread.
+    ~CheckpointWriter();
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a closed writer.
+    CheckpointWriter() = default;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Deleted copy constructor.
+    CheckpointWriter(const CheckpointWriter& o) = delete;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Deleted move constructor.
+    CheckpointWriter(CheckpointWriter&& o) noexcept = delete;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Deleted copy-assignment operator.
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Deleted move-assignment operator.
+    CheckpointWriter& operator=(CheckpointWriter&&) noexcept = delete;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Create a checkpoint file and start the writer thread.
+    /// \param  path            the path to the file to create.
+    /// \param  baseInterval    the number of checkpoints per full base, at
+    ///                         least 1.
+    /// \param  error           set to a description of the problem on failure.
+    /// \return true on success, false otherwise.
+    bool open(
+        const std::string& path, const size_t& baseInterval,
+        std::string& error);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Write pending checkpoints and stop the writer thread.
+    void close();
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Check if the writer accepts checkpoints.
+    /// \return true if open.
+    [[nodiscard]] bool isOpen() const noexcept { return m_thread.joinable(); }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Start a checkpoint, clearing the frame to fill.
+    /// \return true if the frame may be filled and submitted, false if the
+    ///         writer is closed or still busy with earlier checkpoints.
+    bool beginCheckpoint();
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the frame of the started checkpoint.
+    /// \return reference to the material of each cell, row by row.
+    [[nodiscard]] std::vector<std::uint8_t>& getFrame() noexcept {
+        return m_frame;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Hand the filled frame to the writer thread.
+    /// \param  step    the simulation step the frame was taken at.
+    void submit(const std::uint64_t& step);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the counters of the checkpoints written so far.
+    /// \return a copy of the writer's counters.
+    [[nodiscard]] Stats getStats();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Encode the chunks of a frame that differ from the last one.
+    /// \param  previous    the last frame, ignored for a base.
+    /// \param  current     the frame to encode.
+    /// \param  base        true to encode every chunk.
+    /// \param  out         the bytes to append the chunks to.
+    /// \return the number of chunks encoded.
+    static size_t encodeChunks(
+        const std::vector<std::uint8_t>& previous,
+        const std::vector<std::uint8_t>& current, const bool& base,
+        std::vector<std::uint8_t>& out);
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Encode and write submitted frames until closed.
+    void writerLoop();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \struct Pending
+    /// \brief  A submitted frame waiting on the writer thread.
+    struct Pending {
+        std::vector<std::uint8_t> cells; ///< The material of each cell.
+        std::uint64_t step = 0ULL;       ///< The step it was taken at.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    std::ofstream m_file;              ///< The checkpoint stream.
+    size_t m_baseInterval = 1ULL;      ///< Checkpoints per full base.
+    std::vector<std::uint8_t> m_frame; ///< Frame being filled.
+    std::vector<std::uint8_t> m_previous; ///< Last frame written.
+    std::vector<std::uint8_t> m_record;   ///< Record being encoded.
+    size_t m_written = 0ULL;              ///< Checkpoints written so far.
+    std::deque<Pending> m_pending;        ///< Frames waiting to be written.
+    std::vector<std::vector<std::uint8_t>>
+        m_freeFrames;               ///< Frame storage free for reuse.
+    Stats m_stats;                  ///< Checkpoint counters.
+    bool m_running = false;         ///< Keep the writer thread running.
+    std::mutex m_mutex;             ///< Guards everything shared above.
+    std::condition_variable m_wake; ///< Wakes the writer thread.
+    std::thread m_thread;           ///< Thread encoding and writing.
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  CheckpointReader
+/// \brief  Reads back a checkpoint stream, validated and indexed up front,
+///         reconstructing any checkpoint from the nearest base before it.
+class CheckpointReader {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Read and validate a checkpoint stream.
+    /// \param  path    the path to the checkpoint file.
+    /// \param  error   set to a description of the problem on failure.
+    /// \return the reader, or nothing if the file can't be read or parsed.
+    static std::optional<CheckpointReader>
+    load(const std::string& path, std::string& error);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of checkpoints.
+    /// \return the number of checkpoints in the stream.
+    [[nodiscard]] size_t size() const noexcept { return m_records.size(); }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the simulation step a checkpoint was taken at.
+    /// \param  index   the checkpoint's index, below size().
+    /// \return the checkpoint's step.
+    [[nodiscard]] std::uint64_t getStep(const size_t& index) const noexcept {
+#ifdef DEBUG
+        assert(index < size());
+#endif
+        return m_records[index].step;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Check if a checkpoint was written in full.
+    /// \param  index   the checkpoint's index, below size().
+    /// \return true if the checkpoint is a base.
+    [[nodiscard]] bool isBase(const size_t& index) const noexcept {
+#ifdef DEBUG
+        assert(index < size());
+#endif
+        return m_records[index].base;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Rebuild a checkpoint, applying deltas to the base before it.
+    /// \param  index   the checkpoint's index, below size().
+    /// \return the material of each cell, row by row.
+    [[nodiscard]] std::vector<std::uint8_t>
+    reconstruct(const size_t& index) const;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Rebuild a checkpoint as particles for a world builder.
+    /// \param  index   the checkpoint's index, below size().
+    /// \return a descriptor for each occupied cell.
+    [[nodiscard]] std::vector<ParticleDescriptor>
+    describe(const size_t& index) const;
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \struct Record
+    /// \brief  Where a checkpoint's chunks lie within the stream.
+    struct Record {
+        bool base = false;         ///< True if every chunk is present.
+        std::uint64_t step = 0ULL; ///< The step it was taken at.
+        size_t offset = 0ULL;      ///< Index of its first chunk's bytes.
+        size_t chunkCount = 0ULL;  ///< The number of chunks present.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Decode a record's chunks over a frame.
+    /// \param  record  the record to apply.
+    /// \param  frame   the frame to overwrite the chunks of.
+    void apply(const Record& record, std::vector<std::uint8_t>& frame) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    std::string m_bytes;           ///< The whole stream.
+    std::vector<Record> m_records; ///< Every checkpoint, in order.
+};
+
+#endif // CHECKPOINT_HPP
@@ -0,0 +1,45 @@
+#include "checkpointSystem.hpp"
+#include "componentView.hpp"
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+CheckpointSystem::CheckpointSystem(
+    CheckpointWriter& writer, StaticLayer& staticLayer,
+    const std::uint64_t& interval)
+    : m_writer(writer), m_staticLayer(staticLayer),
+      m_interval(std::max<std::uint64_t>(interval, 1ULL)) {
+    addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// updateComponents
+//////////////////////////////////////////////////////////////////////
+
+void CheckpointSystem::updateComponents(
+    const double& /*deltaTime*/,
+    const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
+    if (++m_step % m_interval != 0ULL || !m_writer.beginCheckpoint())
+        return;
+
+    // Only fill in the materials, the writer thread does the rest
+    constexpr int side = CheckpointWriter::SIDE;
+    auto& frame = m_writer.getFrame();
+    for (const auto [particleComponent] :
+         ComponentView<ParticleComponent>(entityComponents)) {
+        const int x = static_cast<int>(particleComponent.m_pos.x());
+        const int y = static_cast<int>(particleComponent.m_pos.y());
+        if (x >= 0 && x < side && y >= 0 && y < side)
+            frame[static_cast<size_t>(y * side + x)] =
+                static_cast<std::uint8_t>(particleComponent.m_material);
+    }
+    for (int y = 0; y < side; ++y)
+        m_staticLayer.getMask().forEach(y, [&](const int& x) {
+            const auto material = m_staticLayer.get(x, y).m_material;
+            frame[static_cast<size_t>(y * side + x)] =
+                static_cast<std::uint8_t>(material);
+        });
+    m_writer.submit(m_step);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef CHECKPOINTSYSTEM_HPP
+#define CHECKPOINTSYSTEM_HPP
+
+#include "checkpoint.hpp"
+#include "components.hpp"
+#include "ecsSystem.hpp"
+#include "staticLayer.hpp"
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  CheckpointSystem
+/// \brief  System capturing the material of every cell every so many
+///         steps, handing the frame to a checkpoint writer.
+class CheckpointSystem final : public ecsSystem {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a checkpoint system.
+    /// \param  writer      the writer to hand frames to.
+    /// \param  staticLayer the static geometry captured along the particles.
+    /// \param  interval    the number of steps between checkpoints.
+    CheckpointSystem(
+        CheckpointWriter& writer, StaticLayer& staticLayer,
+        const std::uint64_t& interval);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Tick this system by deltaTime, once per step.
+    /// \param	deltaTime	    the amount of time passed since last update.
+    /// \param	components	    the components to update.
+    void updateComponents(
+        const double&,
+        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
+        final;
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    CheckpointWriter& m_writer;
+    StaticLayer& m_staticLayer;
+    std::uint64_t m_interval = 1ULL; ///< Steps between checkpoints.
+    std::uint64_t m_step = 0ULL;     ///< Steps taken so far.
+};
+
+#endif // CHECKPOINTSYSTEM_HPP
@@ -3,6 +3,7 @@
 #define COLLISION_HPP
 
 #include "Utility/vec.hpp"
+#include <cmath>
 #include <tuple>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -42,4 +43,52 @@ bool areColliding_BoxVsBox(
 std::tuple<bool, vec2, vec2, float> rayBBoxIntersection(
     const vec2& rayPos, const vec2& rayDir, const vec2& boxCenter,
     const vec2& boxExtents, const bool projectBackwards = false) noexcept;
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Walk a ray through a grid of unit cells, in the order it enters
+///         them, using the same per-axis slab distances as
+///         rayBBoxIntersection.
+/// \param  x           the starting cell's column, updated to the last
+///                     cell entered.
+/// \param  y           the starting cell's row, updated to the last cell
+///                     entered.
+/// \param  rayDir      the ray direction in 2D space, in cells.
+/// \param  maxCells    the most cells to enter.
+/// \param  isBlocked   predicate taking a cell's column and row, stopping
+///                     the walk before any cell it returns true for.
+/// \return the number of cells entered.
+template <typename Func>
+int traverseGrid(
+    int& x, int& y, const vec2& rayDir, const int& maxCells,
+    Func&& isBlocked) noexcept {
+    // Distance along the ray between crossing successive cell borders
+    const vec2 invDir = vec2(1.0F) / rayDir;
+    const float deltaX = std::abs(invDir.x());
+    const float deltaY = std::abs(invDir.y());
+    const int stepX = rayDir.x() < 0.0F ? -1 : 1;
+    const int stepY = rayDir.y() < 0.0F ? -1 : 1;
+
+    // Rays start at cell centers, so the first borders are half a cell out
+    float tMaxX = deltaX * 0.5F;
+    float tMaxY = deltaY * 0.5F;
+    int cells = 0;
+    while (cells < maxCells) {
+        int newX = x;
+        int newY = y;
+        if (tMaxX < tMaxY) {
+            newX += stepX;
+            tMaxX += deltaX;
+        } else {
+            newY += stepY;
+            tMaxY += deltaY;
+        }
+        if (isBlocked(newX, newY))
+            break;
+        x = newX;
+        y = newY;
+        ++cells;
+    }
+    return cells;
+}
+
 #endif // COLLISION_HPP
\ No newline at end of file
@@ -4,8 +4,9 @@
 /// Custom Constructor
 //////////////////////////////////////////////////////////////////////
 
-CollisionCleanupSystem::CollisionCleanupSystem(ecsWorld& gameWorld)
-    : m_gameWorld(gameWorld) {
+CollisionCleanupSystem::CollisionCleanupSystem(
+    ecsWorld& gameWorld, FrameArena& frameArena)
+    : m_gameWorld(gameWorld), m_frameArena(frameArena) {
     addComponentType(
         CollisionManifoldComponent::Runtime_ID, RequirementsFlag::REQUIRED);
 }
@@ -17,15 +18,15 @@ CollisionCleanupSystem::CollisionCleanupSystem(ecsWorld& gameWorld)
 void CollisionCleanupSystem::updateComponents(
     const double& /*deltaTime*/,
     const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
-    std::vector<EntityHandle> entitiesToClean;
+    ArenaVector<EntityHandle> entitiesToClean{ ArenaAllocator<EntityHandle>(
+        m_frameArena) };
     entitiesToClean.reserve(entityComponents.size());
-    for (const auto& components : entityComponents) {
-        auto collisionComponent =
-            static_cast<CollisionManifoldComponent*>(components.front());
-        if (collisionComponent->collisions.empty())
-            entitiesToClean.emplace_back(components.front()->m_entityHandle);
+    for (const auto [collisionComponent] :
+         ComponentView<CollisionManifoldComponent>(entityComponents)) {
+        if (collisionComponent.collisions.empty())
+            entitiesToClean.emplace_back(collisionComponent.m_entityHandle);
         else
-            collisionComponent->collisions.clear();
+            collisionComponent.collisions.clear();
     }
 
     for (const auto& handle : entitiesToClean)
@@ -2,9 +2,11 @@
 #ifndef COLLISIONCLEANUPSYSTEM_HPP
 #define COLLISIONCLEANUPSYSTEM_HPP
 
+#include "componentView.hpp"
 #include "components.hpp"
 #include "ecsSystem.hpp"
 #include "ecsWorld.hpp"
+#include "frameArena.hpp"
 
 ///////////////////////////////////////////////////////////////////////////
 /// Use the shared mini namespace
@@ -18,7 +20,8 @@ class CollisionCleanupSystem final : public ecsSystem {
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Construct a cleanup system.
     /// \param  gameWorld   reference to the engine's game world.
-    explicit CollisionCleanupSystem(ecsWorld& gameWorld);
+    /// \param  frameArena  arena holding this step's scratch data.
+    CollisionCleanupSystem(ecsWorld& gameWorld, FrameArena& frameArena);
 
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Tick this system by deltaTime.
@@ -33,6 +36,7 @@ class CollisionCleanupSystem final : public ecsSystem {
     ///////////////////////////////////////////////////////////////////////////
     /// Private Members
     ecsWorld& m_gameWorld;
+    FrameArena& m_frameArena;
 };
 
 #endif // COLLISIONCLEANUPSYSTEM_HPP
\ No newline at end of file
@@ -6,8 +6,10 @@
 
 CollisionManifoldSystem::CollisionManifoldSystem(
     ecsWorld& gameWorld,
-    std::shared_ptr<ParticleComponent* [513][513]>& particleArray)
-    : m_gameWorld(gameWorld), m_particleArray(particleArray) {
+    std::shared_ptr<ParticleComponent* [513][513]>& particleArray,
+    const OccupancyGrid& occupancy, FrameArena& frameArena)
+    : m_gameWorld(gameWorld), m_particleArray(particleArray),
+      m_occupancy(occupancy), m_frameArena(frameArena) {
     addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
 }
 
@@ -18,43 +20,31 @@ CollisionManifoldSystem::CollisionManifoldSystem(
 void CollisionManifoldSystem::updateComponents(
     const double& /*deltaTime*/,
     const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
-    for (const auto& components : entityComponents) {
-        auto& particleComponent =
-            *static_cast<ParticleComponent*>(components.front());
+    // Share one scratch list between every particle's neighbours
+    using Collision = std::pair<ParticleComponent*, vec2>;
+    ArenaVector<Collision> collidingObjects{ ArenaAllocator<Collision>(
+        m_frameArena) };
+    collidingObjects.reserve(8);
+    for (const auto [particleComponent] :
+         ComponentView<ParticleComponent>(entityComponents)) {
         const auto& entity1Handle = particleComponent.m_entityHandle;
         const auto entity1Pointer = m_gameWorld.getEntity(entity1Handle);
         const int x = static_cast<int>(particleComponent.m_pos.x());
         const int y = static_cast<int>(particleComponent.m_pos.y());
-        std::vector<std::pair<ParticleComponent*, vec2>> collidingObjects;
-        collidingObjects.reserve(8);
+        collidingObjects.clear();
 
-        // Left Side
-        if (x > 0 && y > 0 && m_particleArray[y - 1][x - 1] != nullptr)
-            collidingObjects.emplace_back(
-                m_particleArray[y - 1][x - 1], vec2(-1, -1));
-        if (x > 0 && m_particleArray[y][x - 1] != nullptr)
-            collidingObjects.emplace_back(
-                m_particleArray[y][x - 1], vec2(-1, 0));
-        if (x > 0 && y < 511 && m_particleArray[y + 1][x - 1] != nullptr)
-            collidingObjects.emplace_back(
-                m_particleArray[y + 1][x - 1], vec2(-1, 1));
-        // Middle
-        if (y > 0 && m_particleArray[y - 1][x] != nullptr)
-            collidingObjects.emplace_back(
-                m_particleArray[y - 1][x], vec2(0, -1));
-        if (y < 511 && m_particleArray[y + 1][x] != nullptr)
-            collidingObjects.emplace_back(
-                m_particleArray[y + 1][x], vec2(0, 1));
-        // Right Side
-        if (x < 511 && y > 0 && m_particleArray[y - 1][x + 1] != nullptr)
-            collidingObjects.emplace_back(
-                m_particleArray[y - 1][x + 1], vec2(1, -1));
-        if (x < 511 && m_particleArray[y][x + 1] != nullptr)
-            collidingObjects.emplace_back(
-                m_particleArray[y][x + 1], vec2(1, 0));
-        if (x < 511 && y < 511 && m_particleArray[y + 1][x + 1] != nullptr)
-            collidingObjects.emplace_back(
-                m_particleArray[y + 1][x + 1], vec2(1, 1));
+        // Visit each occupied neighbour from a single 3x3 mask, the guard
+        // band keeps every particle's neighbourhood inside the grid
+        auto neighbours = m_occupancy.innerNeighbours(x, y);
+        while (neighbours != 0U) {
+            const int bit = countTrailingZeros(neighbours);
+            neighbours &= neighbours - 1U;
+            const int dx = (bit % 3) - 1;
+            const int dy = (bit / 3) - 1;
+            collidingObjects.emplace_back(
+                m_particleArray[y + dy][x + dx],
+                vec2(static_cast<float>(dx), static_cast<float>(dy)));
+        }
 
         for (auto& [entity2, normal] : collidingObjects) {
             const auto& entityHandle2 = entity2->m_entityHandle;
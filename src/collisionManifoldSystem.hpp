@@ -2,9 +2,12 @@
 #ifndef COLLISIONSYSTEM_HPP
 #define COLLISIONSYSTEM_HPP
 
+#include "bitboard.hpp"
 #include "collision.hpp"
+#include "componentView.hpp"
 #include "components.hpp"
 #include "ecsWorld.hpp"
+#include "frameArena.hpp"
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -20,9 +23,12 @@ class CollisionManifoldSystem final : public ecsSystem {
     /// \brief  Construct a collision manifold system.
     /// \param  gameWorld       reference to the engine's game world.
     /// \param  particleArray   structure identifying particles spatially.
+    /// \param  occupancy       bits marking the occupied particle cells.
+    /// \param  frameArena      arena holding this step's scratch data.
     CollisionManifoldSystem(
         ecsWorld& gameWorld,
-        std::shared_ptr<ParticleComponent* [513][513]>& particleArray);
+        std::shared_ptr<ParticleComponent* [513][513]>& particleArray,
+        const OccupancyGrid& occupancy, FrameArena& frameArena);
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Tick this system by deltaTime.
     /// \param	deltaTime	    the amount of time passed since last update.
@@ -37,6 +43,8 @@ class CollisionManifoldSystem final : public ecsSystem {
     /// Private Members
     ecsWorld& m_gameWorld;
     std::shared_ptr<ParticleComponent* [513][513]>& m_particleArray;
+    const OccupancyGrid& m_occupancy;
+    FrameArena& m_frameArena;
 };
 
 #endif // COLLISIONSYSTEM_HPP
\ No newline at end of file
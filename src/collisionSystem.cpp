@@ -1,5 +1,52 @@
 #include "collisionSystem.hpp"
+#include "margolus.hpp"
+#include <algorithm>
 #include <array>
+#include <cassert>
+
+//////////////////////////////////////////////////////////////////////
+/// Falling acceleration, in cells per second squared
+constexpr float gravity = 400.0F;
+//////////////////////////////////////////////////////////////////////
+/// Fastest falling speed, in cells per second
+constexpr float terminalVelocity = 640.0F;
+//////////////////////////////////////////////////////////////////////
+/// Materials whose resting cells are settled a word at a time
+constexpr std::array<Material, 2> granularMaterials{ Material::SAND,
+                                                     Material::GUNPOWDER };
+//////////////////////////////////////////////////////////////////////
+/// Layer holding the cells of particles without gravity
+constexpr size_t staticLayer = 0ULL;
+//////////////////////////////////////////////////////////////////////
+/// Rows of Margolus blocks, and the number each parallel chunk resolves
+constexpr size_t blockRows = 256ULL;
+constexpr size_t blockRowGrain = 16ULL;
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Build the layer of each material's falling cells.
+/// \return the layer of each material, -1 for those without one.
+constexpr std::array<int, materialCount> makeMaterialLayers() noexcept {
+    std::array<int, materialCount> layers{};
+    for (auto& layer : layers)
+        layer = -1;
+    for (size_t layer = 0ULL; layer < granularMaterials.size(); ++layer)
+        layers[static_cast<size_t>(granularMaterials[layer])] =
+            static_cast<int>(layer) + 1;
+    return layers;
+}
+//////////////////////////////////////////////////////////////////////
+/// Layer of each material's falling cells
+constexpr std::array<int, materialCount> materialLayers = makeMaterialLayers();
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Find the material layer a particle belongs to.
+/// \param  particle    the particle to classify.
+/// \return the layer index, or -1 if the particle belongs to none.
+static int findLayer(const ParticleComponent& particle) noexcept {
+    return particle.m_useGravity
+               ? materialLayers[static_cast<size_t>(particle.m_material)]
+               : static_cast<int>(staticLayer);
+}
 
 //////////////////////////////////////////////////////////////////////
 /// Custom Constructor
@@ -7,8 +54,14 @@
 
 CollisionSystem::CollisionSystem(
     ecsWorld& gameWorld,
-    std::shared_ptr<ParticleComponent* [513][513]>& particleArray)
-    : m_gameWorld(gameWorld), m_particleArray(particleArray) {
+    std::shared_ptr<ParticleComponent* [513][513]>& particleArray,
+    OccupancyGrid& occupancy, StaticLayer& geometry, ThreadPool& threadPool,
+    const CounterRNG& rng)
+    : m_gameWorld(gameWorld), m_particleArray(particleArray),
+      m_occupancy(occupancy), m_staticLayer(geometry),
+      m_threadPool(threadPool), m_rng(rng),
+      m_layers(granularMaterials.size() + 1ULL),
+      m_demotions(blockRows / blockRowGrain) {
     addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
 }
 
@@ -17,60 +70,456 @@ CollisionSystem::CollisionSystem(
 //////////////////////////////////////////////////////////////////////
 
 void CollisionSystem::updateComponents(
-    const double& /*deltaTime*/,
+    const double& deltaTime,
     const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
-    for (const auto& components : entityComponents) {
-        auto& particleComponent =
-            *static_cast<ParticleComponent*>(components.front());
-        const int x = static_cast<int>(particleComponent.m_pos.x());
-        const int y = static_cast<int>(particleComponent.m_pos.y());
-        m_particleArray[y][x] = &particleComponent;
+    const auto dt = static_cast<float>(deltaTime);
+
+    // Clear last step's particles, only visiting occupied dynamic cells
+    const auto& staticCells = m_staticLayer.getMask();
+    for (int y = 0; y < 513; ++y)
+        for (int index = 0; index < OccupancyGrid::WORDS; ++index)
+            forEachBit(
+                m_occupancy.word(y, index) & ~staticCells.word(y, index),
+                index << 6,
+                [&](const int& x) { m_particleArray[y][x] = nullptr; });
+
+    // Scatter particles into the array, each owning a distinct cell
+    const ComponentView<ParticleComponent> view(entityComponents);
+    m_threadPool.parallelFor(
+        0ULL, view.size(), 4096ULL,
+        [&](const size_t& begin, const size_t& end) {
+            for (auto index = begin; index < end; ++index) {
+                auto [particleComponent] = view[index];
+                const int x = static_cast<int>(particleComponent.m_pos.x());
+                const int y = static_cast<int>(particleComponent.m_pos.y());
+                m_particleArray[y][x] = &particleComponent;
+            }
+        });
+
+    // Rebuild the occupancy and material bits, one thread per row
+    m_threadPool.parallelFor(
+        0ULL, 513ULL, 64ULL, [&](const size_t& begin, const size_t& end) {
+            for (auto y = static_cast<int>(begin); y < static_cast<int>(end);
+                 ++y) {
+                for (int index = 0; index < OccupancyGrid::WORDS; ++index) {
+                    std::uint64_t bits = 0ULL;
+                    std::array<std::uint64_t, granularMaterials.size() + 1ULL>
+                        layerBits{};
+                    std::array<std::uint64_t, 2> behaviourBits{};
+                    const int count = std::min(64, 513 - (index << 6));
+                    for (int bit = 0; bit < count; ++bit) {
+                        const auto* particle =
+                            m_particleArray[y][(index << 6) + bit];
+                        if (particle == nullptr)
+                            continue;
+                        bits |= 1ULL << bit;
+                        const int layer = findLayer(*particle);
+                        if (layer >= 0)
+                            layerBits[layer] |= 1ULL << bit;
+                        const auto behaviour =
+                            static_cast<std::uint64_t>(behaviourOf(*particle));
+                        behaviourBits[0] |= (behaviour & 1ULL) << bit;
+                        behaviourBits[1] |= (behaviour >> 1U) << bit;
+                    }
+                    m_occupancy.word(y, index) = bits;
+                    for (size_t layer = 0; layer < m_layers.size(); ++layer)
+                        m_layers[layer].word(y, index) = layerBits[layer];
+                    m_behaviours[0].word(y, index) = behaviourBits[0];
+                    m_behaviours[1].word(y, index) = behaviourBits[1];
+                }
+            }
+        });
+
+#ifdef DEBUG
+    // Neighbour reads below skip bounds checks, relying on the guard band
+    assert(m_staticLayer.guardBandIntact());
+#endif
+
+    // Alternate block phases, in place of the per-cell rule
+    if (m_mode == Mode::MARGOLUS) {
+        applyMargolus(0);
+        applyMargolus(1);
+        requestDemotions();
+        return;
+    }
+
+    // Cells are grouped by behaviour a word at a time, each group handed to
+    // its own kernel
+    const auto& gravityless = m_layers[staticLayer];
+    const auto gasWord = [&](const int& y, const int& index) {
+        return m_behaviours[0].word(y, index) & m_behaviours[1].word(y, index);
+    };
+
+    // Apply Gravity, only visiting occupied falling cells of the play area
+    for (int y = playMin; y <= playMax; ++y) {
+        // Take the whole row before moving any of it, so liquids spreading
+        // into a later word aren't visited twice
+        const auto settled = findSettledCells(y);
+        std::array<std::uint64_t, OccupancyGrid::WORDS> falling{};
+        std::array<std::uint64_t, OccupancyGrid::WORDS> powder{};
+        for (int index = 0; index < OccupancyGrid::WORDS; ++index) {
+            falling[index] = m_occupancy.word(y, index) &
+                             ~staticCells.word(y, index) &
+                             ~gravityless.word(y, index) & ~gasWord(y, index);
+            // Without static cells and gases, the low bit splits the rest
+            powder[index] = falling[index] & m_behaviours[0].word(y, index);
+        }
+        for (int index = 0; index < OccupancyGrid::WORDS; ++index) {
+            const auto bits = falling[index];
+
+            // Settled cells come to rest without consulting neighbours
+            forEachBit(bits & settled[index], index << 6, [&](const int& x) {
+                auto& particle = *m_particleArray[y][x];
+#ifdef DEBUG
+                // Must match the per-cell rule
+                assert(restsInPlace(particle, x, y));
+#endif
+                if (!particle.m_asleep) {
+                    particle.m_asleep = true;
+                    particle.m_velocity = vec2(0.0F);
+                }
+            });
+
+            // Everything else, including material boundaries, goes per-cell
+            forEachBit(
+                powder[index] & ~settled[index], index << 6,
+                [&](const int& x) { moveCell<Behaviour::POWDER>(x, y, dt); });
+            forEachBit(bits & ~powder[index], index << 6, [&](const int& x) {
+                moveCell<Behaviour::LIQUID>(x, y, dt);
+            });
+        }
+    }
+
+    // Gases rise, so are visited top-down in a pass of their own
+    for (int y = playMax; y >= playMin; --y) {
+        std::array<std::uint64_t, OccupancyGrid::WORDS> rising{};
+        for (int index = 0; index < OccupancyGrid::WORDS; ++index)
+            rising[index] = gasWord(y, index) & m_occupancy.word(y, index) &
+                            ~staticCells.word(y, index);
+        for (int index = 0; index < OccupancyGrid::WORDS; ++index)
+            forEachBit(rising[index], index << 6, [&](const int& x) {
+                moveCell<Behaviour::GAS>(x, y, dt);
+            });
+    }
+    requestDemotions();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// moveCell
+//////////////////////////////////////////////////////////////////////
+
+template <Behaviour B>
+void CollisionSystem::moveCell(const int& x, const int& y, const float& dt) {
+    static_assert(B != Behaviour::STATIC, "static cells never move");
+    // Gases move up the grid, everything else down it
+    constexpr int dy = B == Behaviour::GAS ? 1 : -1;
+    auto& particle1 = m_particleArray[y][x];
+
+    // Only act on particles that can move
+    if (particle1->m_asleep)
+        return;
+
+    // Avoid else branch set to true early
+    particle1->m_asleep = true;
+
+    const auto swapTile = [&](const int& newX, const int& newY) {
+        // Set new position
+        particle1->m_pos =
+            vec2(static_cast<float>(newX), static_cast<float>(newY));
+        particle1->m_asleep = false;
+        // Swap tiles in array, lifting any lighter particle into our place
+        if (m_occupancy.test(newX, newY)) {
+            auto& particle2 = *m_particleArray[newY][newX];
+            particle2.m_pos =
+                vec2(static_cast<float>(x), static_cast<float>(y));
+            moveLayerBit(particle2, newX, newY, x, y);
+        } else {
+            m_occupancy.reset(x, y);
+            m_occupancy.set(newX, newY);
+        }
+        moveLayerBit(*particle1, x, y, newX, newY);
+        swapBehaviours(x, y, newX, newY);
+        std::swap(m_particleArray[y][x], m_particleArray[newY][newX]);
+        // Wake up the particle that rested against this one
+        if (m_occupancy.test(x, y - dy))
+            m_particleArray[y - dy][x]->m_asleep = false;
+    };
+
+    // Check if the next cell is free, falling as far as velocity allows
+    auto& velocity = particle1->m_velocity;
+    if (!m_occupancy.test(x, y + dy)) {
+        if constexpr (B == Behaviour::GAS)
+            // Gases drift up a cell at a time
+            swapTile(x, y + dy);
+        else {
+            velocity.y() =
+                std::max(velocity.y() - gravity * dt, -terminalVelocity);
+            const int maxCells =
+                std::max(1, static_cast<int>(-velocity.y() * dt));
+            int newX = x;
+            int newY = y;
+            traverseGrid(
+                newX, newY, velocity, maxCells,
+                [&](const int& cellX, const int& cellY) {
+                    return m_occupancy.test(cellX, cellY);
+                });
+            swapTile(newX, newY);
+        }
+        return;
     }
 
-    // Apply Gravity
-    for (int y = 0; y < 512; ++y) {
-        for (int x = 0; x < 512; ++x) {
-            auto& particle1 = m_particleArray[y][x];
-
-            // Only act on particles that can move
-            if (particle1 == nullptr || particle1->m_asleep ||
-                !particle1->m_useGravity)
-                continue;
-
-            // Avoid else branch set to true early
-            particle1->m_asleep = true;
-
-            const auto swapTile = [&](const int& newX, const int& newY) {
-                // Set new position
-                particle1->m_pos =
-                    vec2(static_cast<float>(newX), static_cast<float>(newY));
-                particle1->m_asleep = false;
-                // Swap tiles in array
-                std::swap(m_particleArray[y][x], m_particleArray[newY][newX]);
-                // Wake up above particle
-                if (m_particleArray[y + 1][x] != nullptr)
-                    m_particleArray[y + 1][x]->m_asleep = false;
-            };
-
-            // Check if bottom is free
-            if (m_particleArray[y - 1][x] == nullptr ||
-                (m_particleArray[y - 1][x]->m_useGravity &&
-                 m_particleArray[y - 1][x]->m_density < particle1->m_density))
-                swapTile(x, y - 1);
-            // Check if bottom left is free
-            else if (
-                m_particleArray[y - 1][x - 1] == nullptr ||
-                (m_particleArray[y - 1][x - 1]->m_useGravity &&
-                 m_particleArray[y - 1][x - 1]->m_density <
-                     particle1->m_density))
-                swapTile(x - 1, y - 1);
-            // Check if bottom right is free
-            else if (
-                m_particleArray[y - 1][x + 1] == nullptr ||
-                (m_particleArray[y - 1][x + 1]->m_useGravity &&
-                 m_particleArray[y - 1][x + 1]->m_density <
-                     particle1->m_density))
-                swapTile(x + 1, y - 1);
+    // Anything else comes to a stop first
+    velocity = vec2(0.0F);
+
+    // Check if bottom is free or holds a lighter particle
+    // Cells are moved one at a time, so a single list takes the demotions
+    auto& demotions = m_demotions.front();
+    if (canSink<B>(*particle1, x, y + dy, demotions))
+        swapTile(x, y + dy);
+    else {
+        // Check bottom left and right, in a random order
+        const int side = (m_rng(x, y, 0U) & 1U) != 0U ? 1 : -1;
+        if (canSink<B>(*particle1, x + side, y + dy, demotions))
+            swapTile(x + side, y + dy);
+        else if (canSink<B>(*particle1, x - side, y + dy, demotions))
+            swapTile(x - side, y + dy);
+        else if constexpr (B != Behaviour::POWDER) {
+            // Fluids spread sideways into empty cells
+            if (!m_occupancy.test(x + side, y))
+                swapTile(x + side, y);
+            else if (!m_occupancy.test(x - side, y))
+                swapTile(x - side, y);
         }
     }
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////
+/// applyMargolus
+//////////////////////////////////////////////////////////////////////
+
+void CollisionSystem::applyMargolus(const int& offset) {
+    // Swap the toppling preference every step to avoid drifting one way
+    const auto& table =
+        margolusTables[(m_rng.getStep() + static_cast<size_t>(offset)) & 1U];
+    m_threadPool.parallelFor(
+        0ULL, blockRows, blockRowGrain,
+        [&](const size_t& begin, const size_t& end) {
+            auto& demotions = m_demotions[begin / blockRowGrain];
+            for (auto blockRow = begin; blockRow < end; ++blockRow) {
+                const int y = offset + static_cast<int>(blockRow) * 2;
+                for (int x = offset; x < 512; x += 2) {
+                    // Skip empty blocks
+                    if ((m_occupancy.extract(x, y, 2) |
+                         m_occupancy.extract(x, y + 1, 2)) == 0ULL)
+                        continue;
+
+                    const std::array<ParticleComponent**, 4> cells{
+                        &m_particleArray[y][x], &m_particleArray[y][x + 1],
+                        &m_particleArray[y + 1][x],
+                        &m_particleArray[y + 1][x + 1]
+                    };
+                    std::uint8_t state = 0U;
+                    std::uint8_t freeState = 0U;
+                    for (int cell = 0; cell < 4; ++cell) {
+                        // Static cells never move, whatever they hold
+                        const bool fixed = m_staticLayer.test(
+                            x + (cell & 1), y + (cell >> 1));
+                        const auto cellClass = static_cast<std::uint8_t>(
+                            classifyCell(*cells[cell]));
+                        const auto wall =
+                            static_cast<std::uint8_t>(BlockClass::WALL);
+                        state |= static_cast<std::uint8_t>(
+                            (fixed ? wall : cellClass) << (cell * 2));
+                        freeState |=
+                            static_cast<std::uint8_t>(cellClass << (cell * 2));
+                    }
+                    // Return static cells the block would have moved
+                    if (state != freeState &&
+                        table[freeState] != margolusIdentity)
+                        for (int cell = 0; cell < 4; ++cell)
+                            if (m_staticLayer.test(
+                                    x + (cell & 1), y + (cell >> 1)))
+                                demotions.emplace_back(
+                                    x + (cell & 1), y + (cell >> 1));
+                    // The first phase decides who sleeps, only unchanged
+                    // blocks of powder and walls are sure to stay put
+                    const auto sources = table[state];
+                    if (offset == 0)
+                        setAsleep(
+                            cells, x, y,
+                            sources == margolusIdentity &&
+                                isGranularBlock(state));
+                    if (sources == margolusIdentity)
+                        continue;
+
+                    // Move each particle into its destination cell
+                    const std::array<ParticleComponent*, 4> particles{
+                        *cells[0], *cells[1], *cells[2], *cells[3]
+                    };
+                    for (int cell = 0; cell < 4; ++cell) {
+                        const int source = (sources >> (cell * 2)) & 3;
+                        const int cellX = x + (cell & 1);
+                        const int cellY = y + (cell >> 1);
+                        auto* particle = particles[source];
+                        *cells[cell] = particle;
+                        if (particle == nullptr) {
+                            m_occupancy.reset(cellX, cellY);
+                            continue;
+                        }
+                        m_occupancy.set(cellX, cellY);
+                        if (source != cell) {
+                            particle->m_pos = vec2(
+                                static_cast<float>(cellX),
+                                static_cast<float>(cellY));
+                            particle->m_asleep = false;
+                        }
+                    }
+                }
+            }
+        });
+}
+
+//////////////////////////////////////////////////////////////////////
+/// setAsleep
+//////////////////////////////////////////////////////////////////////
+
+void CollisionSystem::setAsleep(
+    const std::array<ParticleComponent**, 4>& cells, const int& x,
+    const int& y, const bool& asleep) {
+    for (int cell = 0; cell < 4; ++cell)
+        if (*cells[cell] != nullptr &&
+            !m_staticLayer.test(x + (cell & 1), y + (cell >> 1)))
+            (*cells[cell])->m_asleep = asleep;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// requestDemotions
+//////////////////////////////////////////////////////////////////////
+
+void CollisionSystem::requestDemotions() {
+    for (auto& demotions : m_demotions) {
+        m_staticLayer.requestDemotions(demotions);
+        demotions.clear();
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// canSink
+//////////////////////////////////////////////////////////////////////
+
+template <Behaviour B>
+bool CollisionSystem::canSink(
+    const ParticleComponent& particle, const int& x, const int& y,
+    StaticLayer::Demotions& demotions) const {
+    if (!m_occupancy.test(x, y))
+        return true;
+
+    // Classes order themselves, densities only matter within a class
+    const auto other = getBehaviour(x, y);
+    if (other == Behaviour::STATIC)
+        return false;
+    bool sinks = false;
+    if constexpr (B == Behaviour::GAS)
+        sinks = weightOf(other) > weightOf(B) ||
+                (other == B &&
+                 m_particleArray[y][x]->m_density > particle.m_density);
+    else
+        sinks = weightOf(other) < weightOf(B) ||
+                (other == B &&
+                 m_particleArray[y][x]->m_density < particle.m_density);
+    if (sinks && m_staticLayer.test(x, y)) {
+        demotions.emplace_back(x, y);
+        return false;
+    }
+    return sinks;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// settledCellsAtRest
+//////////////////////////////////////////////////////////////////////
+
+bool CollisionSystem::settledCellsAtRest() const {
+    bool atRest = true;
+    for (int y = playMin; y <= playMax && atRest; ++y) {
+        const auto settled = findSettledCells(y);
+        for (int index = 0; index < OccupancyGrid::WORDS; ++index)
+            forEachBit(settled[index], index << 6, [&](const int& x) {
+                atRest = atRest && restsInPlace(*m_particleArray[y][x], x, y);
+            });
+    }
+    return atRest;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// restsInPlace
+//////////////////////////////////////////////////////////////////////
+
+bool CollisionSystem::restsInPlace(
+    const ParticleComponent& particle, const int& x, const int& y) const {
+    // Only consulted for checks, whatever it would displace stays put
+    StaticLayer::Demotions ignored;
+    return !canSink<Behaviour::POWDER>(particle, x, y - 1, ignored) &&
+           !canSink<Behaviour::POWDER>(particle, x - 1, y - 1, ignored) &&
+           !canSink<Behaviour::POWDER>(particle, x + 1, y - 1, ignored);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// findSettledCells
+//////////////////////////////////////////////////////////////////////
+
+std::array<std::uint64_t, OccupancyGrid::WORDS>
+CollisionSystem::findSettledCells(const int& y) const noexcept {
+    std::array<std::uint64_t, OccupancyGrid::WORDS> settled{};
+    const auto& staticCells = m_layers[staticLayer];
+    for (size_t layer = staticLayer + 1ULL; layer < m_layers.size(); ++layer) {
+        const auto& cells = m_layers[layer];
+        // A material rests on itself and on anything without gravity, padded
+        // with an empty word either side so shifting across words never
+        // needs a check
+        std::array<std::uint64_t, OccupancyGrid::WORDS + 2> support{};
+        for (int index = 0; index < OccupancyGrid::WORDS; ++index)
+            support[index + 1] =
+                cells.word(y - 1, index) | staticCells.word(y - 1, index);
+        for (int index = 0; index < OccupancyGrid::WORDS; ++index) {
+            const auto below = support[index + 1];
+            const auto belowLeft = (below << 1U) | (support[index] >> 63U);
+            const auto belowRight = (below >> 1U) | (support[index + 2] << 63U);
+            settled[index] |=
+                cells.word(y, index) & below & belowLeft & belowRight;
+        }
+    }
+    return settled;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// moveLayerBit
+//////////////////////////////////////////////////////////////////////
+
+void CollisionSystem::moveLayerBit(
+    const ParticleComponent& particle, const int& fromX, const int& fromY,
+    const int& toX, const int& toY) noexcept {
+    const int layer = findLayer(particle);
+    if (layer < 0)
+        return;
+    m_layers[layer].reset(fromX, fromY);
+    m_layers[layer].set(toX, toY);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// swapBehaviours
+//////////////////////////////////////////////////////////////////////
+
+void CollisionSystem::swapBehaviours(
+    const int& x1, const int& y1, const int& x2, const int& y2) noexcept {
+    for (auto& plane : m_behaviours) {
+        const bool first = plane.test(x1, y1);
+        if (plane.test(x2, y2))
+            plane.set(x1, y1);
+        else
+            plane.reset(x1, y1);
+        if (first)
+            plane.set(x2, y2);
+        else
+            plane.reset(x2, y2);
+    }
+}
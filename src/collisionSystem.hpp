@@ -2,10 +2,19 @@
 #ifndef CollisionSystem_HPP
 #define CollisionSystem_HPP
 
+#include "behaviour.hpp"
+#include "bitboard.hpp"
 #include "collision.hpp"
+#include "componentView.hpp"
 #include "components.hpp"
+#include "counterRNG.hpp"
 #include "ecsWorld.hpp"
+#include "guardBand.hpp"
 #include "quadTree.hpp"
+#include "staticLayer.hpp"
+#include "threadPool.hpp"
+#include <array>
+#include <cstdint>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -18,13 +27,27 @@ using namespace mini;
 ///         A meta system of sorts.
 class CollisionSystem final : public ecsSystem {
     public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \enum   Mode
+    /// \brief  The rule set used to move particles.
+    enum class Mode {
+        CELLULAR, ///< Cells visited bottom-up, swapping in place.
+        MARGOLUS  ///< Independent 2x2 blocks resolved through a lookup table.
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Construct a collision finder system.
     /// \param  gameWorld       reference to the engine's game world.
     /// \param  particleArray   structure identifying particles spatially.
-    explicit CollisionSystem(
+    /// \param  occupancy       bits marking the occupied particle cells.
+    /// \param  geometry        cells left in place, never moved here.
+    /// \param  threadPool      pool to spread parallel loops across.
+    /// \param  rng             the simulation's random number generator.
+    CollisionSystem(
         ecsWorld& gameWorld,
-        std::shared_ptr<ParticleComponent* [513][513]>& particleArray);
+        std::shared_ptr<ParticleComponent* [513][513]>& particleArray,
+        OccupancyGrid& occupancy, StaticLayer& geometry,
+        ThreadPool& threadPool, const CounterRNG& rng);
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Tick this system by deltaTime.
     /// \param	deltaTime	    the amount of time passed since last update.
@@ -33,12 +56,127 @@ class CollisionSystem final : public ecsSystem {
         const double&,
         const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
         final;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Set the rule set used to move particles.
+    /// \param  mode    the new simulation mode.
+    void setMode(const Mode& mode) noexcept { m_mode = mode; }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the rule set used to move particles.
+    /// \return the current simulation mode.
+    [[nodiscard]] Mode getMode() const noexcept { return m_mode; }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Check the settled cells found a word at a time against the
+    ///         per-cell rule, for debug checks. Holds as long as particles
+    ///         of a material share its density.
+    /// \return true if no settled cell could fall or slide.
+    [[nodiscard]] bool settledCellsAtRest() const;
 
     private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Apply the per-cell fall and slide rule to a single particle.
+    /// \tparam B       the behaviour of the particle, which must move.
+    /// \param  x       the particle's column.
+    /// \param  y       the particle's row.
+    /// \param  dt      the length of the step in seconds.
+    template <Behaviour B>
+    void moveCell(const int& x, const int& y, const float& dt);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Apply one phase of the Margolus block rule to the grid.
+    ///         Blocks don't overlap within a phase, so rows of blocks are
+    ///         resolved in parallel.
+    /// \param  offset  the phase's offset of the block grid, 0 or 1.
+    void applyMargolus(const int& offset);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Put the particles of a Margolus block to sleep, or wake
+    ///         them. Sleeping particles may be promoted into the static
+    ///         layer, static cells are left alone.
+    /// \param  cells   the block's cells, bottom row first.
+    /// \param  x       the column of the block's bottom-left cell.
+    /// \param  y       the row of the block's bottom-left cell.
+    /// \param  asleep  true to put the particles to sleep.
+    void setAsleep(
+        const std::array<ParticleComponent**, 4>& cells, const int& x,
+        const int& y, const bool& asleep);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Hand the static cells each chunk found displaced over to the
+    ///         static layer, once the passes joined.
+    void requestDemotions();
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Check if a particle may move into a cell.
+    ///         Static cells never give way, but one that would have is
+    ///         queued to be returned to the world.
+    /// \tparam B           the behaviour of the moving particle.
+    /// \param  particle    the moving particle.
+    /// \param  x           the cell's column.
+    /// \param  y           the cell's row.
+    /// \param  demotions   the calling thread's list of cells to return.
+    /// \return true if the cell is empty, or holds a particle lighter than a
+    ///         falling particle or heavier than a rising one.
+    template <Behaviour B>
+    [[nodiscard]] bool canSink(
+        const ParticleComponent& particle, const int& x, const int& y,
+        StaticLayer::Demotions& demotions) const;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Check if a powder particle can neither fall nor slide.
+    /// \param  particle    the particle to check.
+    /// \param  x           the particle's column.
+    /// \param  y           the particle's row.
+    /// \return true if none of the cells below would give way.
+    [[nodiscard]] bool restsInPlace(
+        const ParticleComponent& particle, const int& x, const int& y) const;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the behaviour of an occupied cell.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    /// \return the behaviour of the cell's particle.
+    [[nodiscard]] Behaviour
+    getBehaviour(const int& x, const int& y) const noexcept {
+        return static_cast<Behaviour>(
+            static_cast<unsigned>(m_behaviours[0].test(x, y)) |
+            (static_cast<unsigned>(m_behaviours[1].test(x, y)) << 1U));
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Exchange the behaviours of two cells.
+    /// \param  x1  the first cell's column.
+    /// \param  y1  the first cell's row.
+    /// \param  x2  the second cell's column.
+    /// \param  y2  the second cell's row.
+    void swapBehaviours(
+        const int& x1, const int& y1, const int& x2, const int& y2) noexcept;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Find the granular cells of a row resting on their own kind.
+    ///         Computed 64 cells at a time from the material layers, such
+    ///         cells cannot fall or slide this step.
+    /// \param  y       the row, inside the guard band.
+    /// \return the settled cells of each word of the row.
+    [[nodiscard]] std::array<std::uint64_t, OccupancyGrid::WORDS>
+    findSettledCells(const int& y) const noexcept;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Move a particle's bit between the material layers.
+    /// \param  particle    the particle to move.
+    /// \param  fromX       the column it leaves.
+    /// \param  fromY       the row it leaves.
+    /// \param  toX         the column it enters.
+    /// \param  toY         the row it enters.
+    void moveLayerBit(
+        const ParticleComponent& particle, const int& fromX, const int& fromY,
+        const int& toX, const int& toY) noexcept;
+
     ///////////////////////////////////////////////////////////////////////////
     /// Private Members
     ecsWorld& m_gameWorld;
     std::shared_ptr<ParticleComponent* [513][513]>& m_particleArray;
+    OccupancyGrid& m_occupancy;
+    StaticLayer& m_staticLayer;
+    ThreadPool& m_threadPool;
+    const CounterRNG& m_rng;
+    Mode m_mode = Mode::CELLULAR;        ///< The rule set moving particles.
+    std::vector<OccupancyGrid> m_layers; ///< Cells without gravity, then
+                                         ///< cells of each granular material.
+    std::array<OccupancyGrid, 2>
+        m_behaviours; ///< Behaviour of each cell, as low and high bits.
+    std::vector<StaticLayer::Demotions>
+        m_demotions; ///< Static cells to return, a list per parallel chunk.
 };
 
 #endif // CollisionSystem_HPP
\ No newline at end of file
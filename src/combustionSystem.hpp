@@ -3,41 +3,35 @@
 #define COMBUSTIONSYSTEM_HPP
 
 #include "components.hpp"
-#include "ecsSystem.hpp"
 #include "ecsWorld.hpp"
-#include <vector>
+#include "timerWheel.hpp"
 
 ///////////////////////////////////////////////////////////////////////////
 /// Use the shared mini namespace
 using namespace mini;
 
 ///////////////////////////////////////////////////////////////////////////
-/// \class  ExplosionSystem
+/// \class  CombustionSystem
 /// \brief  Class is used to combust explosive entities.
-class CombustionSystem final : public ecsSystem {
+///         Only touches entities whose fuse timer fires this step.
+class CombustionSystem final {
     public:
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief  Construct a cleanup system.
-    /// \param  gameWorld       reference to the engine's game world.
-    /// \param  particleArray   structure identifying particles spatially.
+    /// \brief  Construct a combustion system.
+    /// \param  gameWorld   reference to the engine's game world.
+    /// \param  fuseTimers  timers scheduled for burning explosive entities.
     CombustionSystem(
-        ecsWorld& gameWorld,
-        std::shared_ptr<ParticleComponent* [513][513]>& particleArray);
+        ecsWorld& gameWorld, TimerWheel<FireTimer>& fuseTimers);
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief  Tick this system by deltaTime.
-    /// \param	deltaTime	    the amount of time passed since last update.
-    /// \param	components	    the components to update.
-    void updateComponents(
-        const double&,
-        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
-        final;
+    /// \brief  Tick this system ahead by a single step.
+    void update();
 
     private:
     ///////////////////////////////////////////////////////////////////////////
     /// Private Members
     ecsWorld& m_gameWorld;
-    std::shared_ptr<ParticleComponent* [513][513]>& m_particleArray;
+    TimerWheel<FireTimer>& m_fuseTimers;
 };
 
-#endif // COMBUSTIONSYSTEM_HPP
\ No newline at end of file
+#endif // COMBUSTIONSYSTEM_HPP
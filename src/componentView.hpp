@@ -0,0 +1,127 @@
+#pragma once
+#ifndef COMPONENTVIEW_HPP
+#define COMPONENTVIEW_HPP
+
+#include "ecsComponent.hpp"
+#include <tuple>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+/////////////////////////////////////////////////////////////////////////
+/// \struct ViewElement
+/// \brief  Converts a base component into a typed reference.
+/// \tparam T   The type of required component.
+template <typename T> struct ViewElement {
+    using type = T&;
+    static type get(ecsBaseComponent* component) noexcept {
+        return *static_cast<T*>(component);
+    }
+};
+/////////////////////////////////////////////////////////////////////////
+/// \struct ViewElement
+/// \brief  Converts a base component into a typed, possibly null, pointer.
+/// \tparam T   The type of optional component.
+template <typename T> struct ViewElement<T*> {
+    using type = T*;
+    static type get(ecsBaseComponent* component) noexcept {
+        return static_cast<T*>(component);
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  ComponentView
+/// \brief  A typed, non-owning view over the components given to a system.
+///         Yields a tuple per entity, holding a reference to each required
+///         component and a pointer to each optional component, in the order
+///         the system added them. Performs no allocations.
+/// \tparam Ts  The component types, pointers denoting optional components.
+template <typename... Ts> class ComponentView {
+    public:
+    using Components = std::vector<std::vector<ecsBaseComponent*>>;
+    using value_type = std::tuple<typename ViewElement<Ts>::type...>;
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \class  Iterator
+    /// \brief  Iterates over entities, yielding their typed components.
+    class Iterator {
+        public:
+        /////////////////////////////////////////////////////////////////////
+        /// \brief  Construct an iterator at a given entity.
+        explicit Iterator(Components::const_iterator it) noexcept : m_it(it) {}
+        value_type operator*() const noexcept {
+            return ComponentView::get(*m_it);
+        }
+        Iterator& operator++() noexcept {
+            ++m_it;
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const noexcept {
+            return m_it != other.m_it;
+        }
+
+        private:
+        Components::const_iterator m_it;
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a view over a system's components.
+    /// \param  entityComponents    the components given to the system.
+    explicit ComponentView(const Components& entityComponents) noexcept
+        : m_entityComponents(entityComponents) {}
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve an iterator to the first entity.
+    /// \return iterator to the first entity.
+    [[nodiscard]] Iterator begin() const noexcept {
+        return Iterator(m_entityComponents.cbegin());
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve an iterator past the last entity.
+    /// \return iterator past the last entity.
+    [[nodiscard]] Iterator end() const noexcept {
+        return Iterator(m_entityComponents.cend());
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of entities in this view.
+    /// \return the number of entities.
+    [[nodiscard]] size_t size() const noexcept {
+        return m_entityComponents.size();
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the typed components of a single entity.
+    /// \param  index   the index of the entity.
+    /// \return tuple of typed components.
+    [[nodiscard]] value_type operator[](const size_t& index) const noexcept {
+        return get(m_entityComponents[index]);
+    }
+
+    private:
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Convert an entity's components into typed references.
+    /// \param  components  the entity's base components.
+    /// \return tuple of typed components.
+    static value_type
+    get(const std::vector<ecsBaseComponent*>& components) noexcept {
+        return get(components, std::index_sequence_for<Ts...>{});
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Convert an entity's components into typed references.
+    /// \param  components  the entity's base components.
+    /// \return tuple of typed components.
+    template <size_t... Is>
+    static value_type get(
+        const std::vector<ecsBaseComponent*>& components,
+        std::index_sequence<Is...> /*unused*/) noexcept {
+        return value_type(ViewElement<Ts>::get(components[Is])...);
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    const Components& m_entityComponents;
+};
+
+#endif // COMPONENTVIEW_HPP
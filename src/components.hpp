@@ -12,13 +12,40 @@
 /// Use the shared mini namespace
 using namespace mini;
 
+///////////////////////////////////////////////////////////////////////////
+/// \brief  True if fire state only lives in ParticleComponent::m_state.
+///         Otherwise igniting, burning out and detonating also add and remove
+///         the fire components, each a structural change to the world.
+#ifdef STATE_FLAGS
+constexpr bool useStateFlags = true;
+#else
+constexpr bool useStateFlags = false;
+#endif
+
 ///////////////////////////////////////////////////////////////////////////
 /// \class  ParticleComponent
 struct ParticleComponent final : public ecsComponent<ParticleComponent> {
+    ///////////////////////////////////////////////////////////////////////
+    /// \enum   State
+    /// \brief  Bit flags of a particle's fire state, kept up to date in
+    ///         either mode. Particles made with fire components must set the
+    ///         matching flags, as reactions test the flags first.
+    enum State : std::uint8_t {
+        FLAMMABLE = 1U << 0U, ///< Can still be ignited.
+        EXPLOSIVE = 1U << 1U, ///< Detonates once its fuse burns down.
+        BURNING = 1U << 2U,   ///< Currently on fire.
+        INERT = 1U << 3U,     ///< Burnt-out residue.
+    };
+
     vec3 m_color = vec3(1.0F);
     vec2 m_pos = vec2(0.0F);
+    vec2 m_velocity = vec2(0.0F);
     float m_health = 1.0F;
     float m_density = 1.0f;
+    Material m_material = Material::NONE;
+    std::uint8_t m_state = 0U;
+    std::uint8_t m_restSteps = 0U;
+    std::uint8_t m_ignition = 0U; ///< Bumped each time it's put out.
     bool m_useGravity = true;
     bool m_asleep = false;
 };
@@ -35,7 +62,9 @@ struct CollisionManifoldComponent final
 };
 
 struct FlammableComponent : public ecsComponent<FlammableComponent> {
-    float wickTime = 1.0F; ///< How long it will burn for.
+    float wickTime = 1.0F;           ///< How long it will burn for.
+    float ignitionPoint = 250.0F;    ///< Temperature it catches fire at.
+    float flameTemperature = 600.0F; ///< Heat it holds its cell at burning.
 };
 struct ExplosiveComponent : public ecsComponent<ExplosiveComponent> {
     float fuseTime = 1.0F; ///< How long it must burn until detonation.
@@ -43,4 +72,22 @@ struct ExplosiveComponent : public ecsComponent<ExplosiveComponent> {
 struct OnFireComponent : public ecsComponent<OnFireComponent> {};
 struct SpawnerComponent : public ecsComponent<SpawnerComponent> {};
 
+///////////////////////////////////////////////////////////////////////////
+/// \struct FireTimer
+/// \brief  A burn-out or detonation timer of a single ignition. It's stale
+///         once the particle's ignition count has moved on.
+struct FireTimer {
+    EntityHandle handle;        ///< The entity set on fire.
+    std::uint8_t ignition = 0U; ///< Its ParticleComponent::m_ignition then.
+
+    ///////////////////////////////////////////////////////////////////////
+    /// \brief  Check this timer belongs to the particle's current ignition.
+    /// \param  particle    the particle set on fire.
+    /// \return true unless the particle was put out since this was set.
+    [[nodiscard]] bool
+    isCurrent(const ParticleComponent& particle) const noexcept {
+        return particle.m_ignition == ignition;
+    }
+};
+
 #endif // COMPONENTS_HPP
\ No newline at end of file
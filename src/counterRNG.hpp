@@ -0,0 +1,94 @@
+#pragma once
+#ifndef COUNTERRNG_HPP
+#define COUNTERRNG_HPP
+
+#include <cstdint>
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  CounterRNG
+/// \brief  A stateless, counter-based random number generator.
+///         Every number is a pure function of the seed, the step, a cell
+///         and a stream, so results never depend on the order or thread
+///         that draws them. Uses the "Squares" generator by B. Widynski.
+class CounterRNG {
+    public:
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a generator from a seed.
+    /// \param  seed    the seed to derive this generator's key from.
+    explicit CounterRNG(const std::uint64_t& seed = 0ULL) noexcept
+        : m_key(makeKey(seed)) {}
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Set the simulation step numbers are drawn for.
+    /// \param  step    the current step.
+    void setStep(const std::uint64_t& step) noexcept { m_step = step; }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the simulation step numbers are drawn for.
+    /// \return the current step.
+    [[nodiscard]] std::uint64_t getStep() const noexcept { return m_step; }
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Draw a random number for a cell this step.
+    /// \param  x       the cell's column.
+    /// \param  y       the cell's row.
+    /// \param  stream  distinguishes independent draws for the same cell.
+    /// \return a uniformly distributed 32-bit number.
+    [[nodiscard]] std::uint32_t
+    operator()(const int& x, const int& y, const std::uint32_t& stream) const
+        noexcept {
+        // 37 bits of step, 19 bits of cell, 8 bits of stream
+        const auto cell = static_cast<std::uint64_t>(y * 513 + x);
+        return squares(
+            (m_step << 27U) | ((cell & 0x7FFFFULL) << 8U) | (stream & 0xFFU),
+            m_key);
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Draw a random float for a cell this step.
+    /// \param  x       the cell's column.
+    /// \param  y       the cell's row.
+    /// \param  stream  distinguishes independent draws for the same cell.
+    /// \return a uniformly distributed float within [0, 1).
+    [[nodiscard]] float
+    uniform(const int& x, const int& y, const std::uint32_t& stream) const
+        noexcept {
+        return static_cast<float>((*this)(x, y, stream) >> 8U) * 0x1.0p-24F;
+    }
+
+    private:
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  The Squares counter-based generator.
+    /// \param  counter     the counter to hash.
+    /// \param  key         the generator key.
+    /// \return a random 32-bit number.
+    static std::uint32_t
+    squares(const std::uint64_t& counter, const std::uint64_t& key) noexcept {
+        std::uint64_t x = counter * key;
+        const std::uint64_t y = x;
+        const std::uint64_t z = y + key;
+        x = x * x + y;
+        x = (x >> 32U) | (x << 32U);
+        x = x * x + z;
+        x = (x >> 32U) | (x << 32U);
+        x = x * x + y;
+        x = (x >> 32U) | (x << 32U);
+        return static_cast<std::uint32_t>((x * x + z) >> 32U);
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Derive a well mixed, odd generator key from a seed.
+    /// \param  seed    the seed to derive from.
+    /// \return a generator key.
+    static std::uint64_t makeKey(const std::uint64_t& seed) noexcept {
+        // SplitMix64 finalizer
+        std::uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+        return (z ^ (z >> 31U)) | 1ULL;
+    }
+
+    /////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    std::uint64_t m_key = 1ULL;  ///< Key derived from the seed.
+    std::uint64_t m_step = 0ULL; ///< The current simulation step.
+};
+
+#endif // COUNTERRNG_HPP
@@ -2,122 +2,227 @@
 #include "GLFW/glfw3.h"
 #include "collision.hpp"
 #include "components.hpp"
-#include <algorithm>
-#include <random>
+#include "guardBand.hpp"
+#include "materials.hpp"
+#include "worldBuilder.hpp"
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+//////////////////////////////////////////////////////////////////////
+/// Simulated seconds between checkpoints, and checkpoints per full base
+constexpr double checkpointSeconds = 2.0;
+constexpr size_t checkpointsPerBase = 16ULL;
 
 //////////////////////////////////////////////////////////////////////
 /// Custom Constructor
 //////////////////////////////////////////////////////////////////////
 
-Engine::Engine(const Window& window)
-    : m_window(window),
+Engine::Engine(
+    const Window& window, const bool& pipelined, const std::string& scenePath,
+    const std::string& checkpointPath)
+    : m_window(window), m_fusedZone(m_profiler.addZone("Fused Cleanup")),
+      m_scheduler(m_threadPool, m_profiler),
       m_particleArray(std::shared_ptr<ParticleComponent* [513][513]>(
-          new ParticleComponent*[513][513])),
-      m_collision(m_gameWorld, m_particleArray),
-      m_manifolds(m_gameWorld, m_particleArray),
-      m_spawnerSystem(m_gameWorld, m_particleArray), m_igniter(m_gameWorld),
-      m_burner(m_gameWorld), m_combuster(m_gameWorld, m_particleArray),
-      m_cleanupSystem(m_gameWorld), m_collisionCleanup(m_gameWorld) {
-    // Random number generation variables
-    std::uniform_real_distribution<float> randomFloats(-1.0F, 1.0F);
-    std::mt19937 generator(0);
-    const auto randNum = [&](const float& low, const float& high) {
-        return std::round(
-            ((0.5F * randomFloats(generator) + 0.5F) * (high - low)) + low);
-    };
-
-    /* // Fill game world with sand
-     for (auto x = 0; x < 50000; ++x) {
-         ParticleComponent particle;
-         FlammableComponent flammable;
-         ExplosiveComponent explosive;
-         const auto entityHandle = m_gameWorld.makeEntity();
-
-         constexpr float numEntityTypes = 4.0F;
-         const int entType = static_cast<int>(randNum(0, 3));
-         switch (entType) {
-         // default:
-         case 0: // Make Sand
-             particle.m_health = 10.0F;
-             particle.m_density = 1.0F;
-             particle.m_color = COLOR_SAND;
-             break;
-         case 1: // Make Oil
-             flammable.wickTime = 4.0F;
-             particle.m_health = 4.0F;
-             particle.m_density = 0.6F;
-             particle.m_color = COLOR_OIL;
-             m_gameWorld.makeComponent(entityHandle, &flammable);
-             break;
-         case 2: // Make Gunpowder
-             explosive.fuseTime = 0.125F;
-             flammable.wickTime = 1.5F;
-             particle.m_health = 2.5F;
-             particle.m_density = 0.8F;
-             particle.m_color = COLOR_GUNPOWDER;
-             m_gameWorld.makeComponent(entityHandle, &explosive);
-             m_gameWorld.makeComponent(entityHandle, &flammable);
-             break;
-         case 3: // Make gasoline
-             explosive.fuseTime = 0.875F;
-             flammable.wickTime = 7.5F;
-             particle.m_health = 7.5F;
-             particle.m_density = 0.4F;
-             particle.m_color = COLOR_GASOLINE;
-             m_gameWorld.makeComponent(entityHandle, &explosive);
-             m_gameWorld.makeComponent(entityHandle, &flammable);
-             break;
-         }
-         particle.m_useGravity = true;
-         particle.m_pos = vec2(
-             (randomFloats(generator) * 0.5F + 0.5F) * 511,
-             ((randomFloats(generator) * 0.5F + 0.5F) * 200) + 311);
-         m_gameWorld.makeComponent(entityHandle, &particle);
-     }*/
-
+          new ParticleComponent*[513][513]())),
+      m_heatField(513, 513),
+      m_staticLayer(m_particleArray, m_occupancy),
+      m_entityPool(m_gameWorld),
+      m_collision(
+          m_gameWorld, m_particleArray, m_occupancy, m_staticLayer,
+          m_threadPool, m_rng),
+      m_staticGeometry(
+          m_gameWorld, m_staticLayer, m_entityPool, m_frameArena),
+      m_manifolds(m_gameWorld, m_particleArray, m_occupancy, m_frameArena),
+      m_spawnerSystem(m_gameWorld, m_occupancy, m_rng, m_entityPool),
+      m_igniter(m_gameWorld, m_burnTimers, m_fuseTimers),
+      m_reactions(
+          m_gameWorld, m_particleArray, m_occupancy, m_staticLayer,
+          m_igniter, m_threadPool),
+      m_heatSources(m_heatField),
+      m_heatIgnition(m_gameWorld, m_heatField, m_igniter, m_frameArena),
+      m_burner(m_gameWorld, m_burnTimers),
+      m_combuster(m_gameWorld, m_fuseTimers),
+      m_cleanupSystem(m_gameWorld, m_frameArena, m_entityPool),
+      m_collisionCleanup(m_gameWorld, m_frameArena),
+      m_renderSystem(m_staticLayer),
+      m_snapshotSystem(m_snapshots, m_staticLayer),
+      m_checkpointSystem(
+          m_checkpoints, m_staticLayer,
+          static_cast<std::uint64_t>(std::lround(
+              checkpointSeconds / m_stepController.getTimeStep()))),
+      m_pipelined(pipelined) {
     {
-        for (int x = 0; x < 512; ++x) {
-            // Add concrete particles to world
-            ParticleComponent particle;
-            // FlammableComponent flammable;
-            // flammable.wickTime = 1000.0F;
-            particle.m_pos = vec2(static_cast<float>(x), 0.0F);
-            particle.m_color = COLOR_CONCRETE;
-            particle.m_health = 1000.0F;
-            particle.m_density = 1000.0F;
-            particle.m_useGravity = false;
-            auto entityHandle = m_gameWorld.makeEntity();
-            m_gameWorld.makeComponent(entityHandle, &particle);
-            entityHandle = m_gameWorld.makeEntity();
-            particle.m_pos = vec2(0, static_cast<float>(x));
-            m_gameWorld.makeComponent(entityHandle, &particle);
-            entityHandle = m_gameWorld.makeEntity();
-            particle.m_pos = vec2(511, static_cast<float>(x));
-            m_gameWorld.makeComponent(entityHandle, &particle);
-        }
+        // Ring the play area with concrete walls, the grid's guard band
+        m_staticLayer.addGuardBand(makePreset(Material::CONCRETE).particle);
 
         ParticleComponent particle;
         particle.m_health = 1000.0F;
         particle.m_density = 1000.0F;
-        particle.m_pos = vec2(256, 511);
+        particle.m_pos = vec2(256, playMax);
         particle.m_color = COLOR_FIRE;
         particle.m_useGravity = false;
         auto entityHandle = m_gameWorld.makeEntity();
         m_gameWorld.makeComponent(entityHandle, &particle);
         m_gameWorld.makeComponent<SpawnerComponent>(entityHandle);
     }
+
+    // Fill the play area from a material map, if one was given
+    if (!scenePath.empty()) {
+        std::string error;
+        if (const auto scene = loadMaterialMap(scenePath, error))
+            WorldBuilder(m_gameWorld, m_occupancy, m_staticLayer)
+                .build(*scene);
+        else
+            std::cout << error << std::endl;
+    }
+
+    // Schedule every system run per step, declaring the data each touches.
+    // Only tasks adding or removing entities and components write their
+    // lists, fire components only come and go without state flags
+    using Resource = SystemScheduler::Resource;
+    constexpr std::uint32_t fireLists =
+        useStateFlags ? 0U : static_cast<std::uint32_t>(Resource::ENTITIES);
+    m_scheduler.addTask(
+        "Collision", Resource::ENTITIES, Resource::PARTICLES | Resource::GRID,
+        [&] {
+            // Rebuild the grids and apply physics
+            m_gameWorld.updateSystem(
+                m_collision, m_stepController.getTimeStep());
+        });
+
+    m_scheduler.addTask(
+        "Reactions", Resource::ENTITIES,
+        Resource::PARTICLES | Resource::GRID | Resource::FIRE |
+            Resource::BURN_TIMERS | Resource::FUSE_TIMERS | fireLists,
+        [&] {
+            // React touching particles, while the grid is freshly rebuilt
+            m_reactions.update(m_stepController.getTimeStep());
+        });
+
+    // Apply collision manifolds
+    // m_scheduler.addTask("Manifolds", ...,
+    //     [&] { m_gameWorld.updateSystem(m_manifolds, timeStep); });
+
+    m_scheduler.addTask(
+        "Spawner", Resource::SPAWNERS,
+        Resource::ENTITIES | Resource::PARTICLES | Resource::GRID, [&] {
+            m_gameWorld.updateSystem(
+                m_spawnerSystem, m_stepController.getTimeStep());
+        });
+    m_scheduler.addTask(
+        "Heat Sources",
+        Resource::ENTITIES | Resource::PARTICLES | Resource::FIRE,
+        Resource::HEAT, [&] {
+            // Fires heat their own cells
+            m_gameWorld.updateSystem(
+                m_heatSources, m_stepController.getTimeStep());
+        });
+    m_scheduler.addTask("Heat Diffusion", 0U, Resource::HEAT, [&] {
+        // Only touches the heat field, so runs alongside the fire timers
+        m_heatField.diffuse(
+            static_cast<float>(m_stepController.getTimeStep()), m_threadPool);
+    });
+    m_scheduler.addTask(
+        "Burning", Resource::ENTITIES,
+        Resource::PARTICLES | Resource::FIRE | Resource::BURN_TIMERS |
+            fireLists,
+        [&] {
+            // Burn-out particles whose wicks expired
+            m_burner.update();
+        });
+    m_scheduler.addTask(
+        "Combustion", Resource::ENTITIES | Resource::MANIFOLDS,
+        Resource::PARTICLES | Resource::FIRE | Resource::FUSE_TIMERS |
+            fireLists,
+        [&] {
+            // Explode combustible particles whose fuses expired
+            m_combuster.update();
+        });
+    m_scheduler.addTask(
+        "Heat Ignition", Resource::ENTITIES | Resource::HEAT,
+        Resource::PARTICLES | Resource::FIRE | Resource::BURN_TIMERS |
+            Resource::FUSE_TIMERS | fireLists,
+        [&] {
+            // Ignite what the diffused heat made hot enough
+            m_gameWorld.updateSystem(
+                m_heatIgnition, m_stepController.getTimeStep());
+        });
+    m_scheduler.addTask(
+        "Static Geometry", 0U,
+        Resource::ENTITIES | Resource::PARTICLES | Resource::GRID, [&] {
+            // Promote resting particles and return disturbed ones. Moving
+            // particles in and out of the world invalidates the grid's
+            // pointers, so this runs once every system reading them is done
+            m_gameWorld.updateSystem(
+                m_staticGeometry, m_stepController.getTimeStep());
+        });
+    m_scheduler.addTask(
+        "Entity Cleanup", 0U,
+        Resource::ENTITIES | Resource::PARTICLES | Resource::FIRE |
+            Resource::MANIFOLDS | Resource::SPAWNERS,
+        [&] {
+            // Delete dead or out-of-bounds particles, unless fused
+            if (!m_stepController.getStepFusion())
+                m_gameWorld.updateSystem(
+                    m_cleanupSystem, m_stepController.getTimeStep());
+        });
+    m_scheduler.addTask(
+        "Collision Cleanup", 0U, Resource::ENTITIES | Resource::MANIFOLDS,
+        [&] {
+            // Remove collision manifolds
+            m_gameWorld.updateSystem(
+                m_collisionCleanup, m_stepController.getTimeStep());
+        });
+#ifdef DEBUG
+    // Diffusion only touches the heat field, it mustn't queue behind fires
+    assert(!m_scheduler.isOrdered("Heat Diffusion", "Burning"));
+    assert(!m_scheduler.isOrdered("Heat Diffusion", "Combustion"));
+#endif
+
+    // Optionally stream checkpoints, once every step's changes are in
+    if (!checkpointPath.empty()) {
+        std::string error;
+        if (m_checkpoints.open(checkpointPath, checkpointsPerBase, error))
+            m_scheduler.addTask(
+                "Checkpoint",
+                Resource::ENTITIES | Resource::PARTICLES | Resource::GRID, 0U,
+                [&] {
+                    // Capture cell materials, encoded and written elsewhere
+                    m_gameWorld.updateSystem(
+                        m_checkpointSystem, m_stepController.getTimeStep());
+                });
+        else
+            std::cout << error << std::endl;
+    }
+
+    // Optionally hand the game logic off to its own thread
+    if (m_pipelined) {
+        m_simulating = true;
+        m_simulationThread = std::thread(&Engine::simulationLoop, this);
+    }
 }
 
 //////////////////////////////////////////////////////////////////////
-/// tick
+/// Destructor
 //////////////////////////////////////////////////////////////////////
 
-#include <iostream>
-#include <string>
+Engine::~Engine() {
+    m_simulating = false;
+    if (m_simulationThread.joinable())
+        m_simulationThread.join();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// tick
+//////////////////////////////////////////////////////////////////////
 
 void Engine::tick(const double& deltaTime) {
     const auto start = glfwGetTime();
-    gameTick(deltaTime);
+    if (!m_pipelined)
+        gameTick(deltaTime);
     renderTick(deltaTime);
     const auto end = glfwGetTime();
 
@@ -129,31 +234,26 @@ void Engine::tick(const double& deltaTime) {
 //////////////////////////////////////////////////////////////////////
 
 void Engine::gameTick(const double& deltaTime) {
-    constexpr double timeStep = 0.025;
-    m_accumulator += deltaTime;
-    while (m_accumulator >= timeStep) {
-        // Clear particle pointer array
-        std::fill(&m_particleArray[0][0], &m_particleArray[512][512], nullptr);
-        // Apply physics
-        m_gameWorld.updateSystem(m_collision, timeStep);
-
-        // Apply collision manifolds
-        // m_gameWorld.updateSystem(m_manifolds, timeStep);
-
-        m_gameWorld.updateSystem(m_spawnerSystem, timeStep);
-
-        // Ignite particles touching burning particles
-        m_gameWorld.updateSystem(m_igniter, timeStep);
-        // Hurt burning particles over-time
-        m_gameWorld.updateSystem(m_burner, timeStep);
-        // Explode burning combustible particles
-        m_gameWorld.updateSystem(m_combuster, timeStep);
-        // Delete dead or out-of-bounds particles
-        m_gameWorld.updateSystem(m_cleanupSystem, timeStep);
-        // Remove collision manifolds
-        m_gameWorld.updateSystem(m_collisionCleanup, timeStep);
-        m_accumulator -= timeStep;
+    const auto timeStep = m_stepController.getTimeStep();
+    const auto steps = m_stepController.beginFrame(deltaTime);
+    for (size_t step = 0ULL; step < steps; ++step) {
+        // Scratch data only lives a step, release the last one's at once
+        m_frameArena.reset();
+        m_rng.setStep(m_rng.getStep() + 1ULL);
+        m_profiler.beginStep();
+        m_scheduler.run();
+    }
+
+    // Fused, dead particles are only deleted once all steps have run
+    if (m_stepController.getStepFusion() && steps > 0ULL) {
+        const Profiler::Scope scope(&m_fusedZone);
+        m_gameWorld.updateSystem(
+            m_cleanupSystem, static_cast<double>(steps) * timeStep);
     }
+
+    // Publish the new world state for the render thread
+    if (m_pipelined && steps > 0ULL)
+        m_gameWorld.updateSystem(m_snapshotSystem, 0.0);
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -161,5 +261,31 @@ void Engine::gameTick(const double& deltaTime) {
 //////////////////////////////////////////////////////////////////////
 
 void Engine::renderTick(const double& deltaTime) {
-    m_gameWorld.updateSystem(m_renderSystem, deltaTime);
+    if (m_pipelined) {
+        // Draw the latest snapshot, the world belongs to the simulation
+        m_snapshots.consume();
+        m_renderSystem.render(m_snapshots.getReadBuffer());
+    } else
+        m_gameWorld.updateSystem(m_renderSystem, deltaTime);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// simulationLoop
+//////////////////////////////////////////////////////////////////////
+
+void Engine::simulationLoop() {
+    using clock = std::chrono::steady_clock;
+    auto lastTime = clock::now();
+    while (m_simulating) {
+        const auto time = clock::now();
+        gameTick(std::chrono::duration<double>(time - lastTime).count());
+        lastTime = time;
+
+        // Sleep until the next step is due
+        const auto timeStep = m_stepController.getTimeStep();
+        std::this_thread::sleep_until(
+            time + std::chrono::duration_cast<clock::duration>(
+                       std::chrono::duration<double>(
+                           timeStep * (1.0 - m_stepController.getAlpha()))));
+    }
 }
\ No newline at end of file
@@ -5,16 +5,38 @@
 #include "CollisionManifoldSystem.hpp"
 #include "CollisionSystem.hpp"
 #include "Utility/vec.hpp"
+#include "bitboard.hpp"
 #include "burningSystem.hpp"
+#include "checkpoint.hpp"
+#include "checkpointSystem.hpp"
 #include "collisionCleanupSystem.hpp"
+#include "counterRNG.hpp"
 #include "combustionSystem.hpp"
 #include "ecsWorld.hpp"
 #include "entityCleanupSystem.hpp"
+#include "entityPool.hpp"
+#include "frameArena.hpp"
+#include "heatField.hpp"
+#include "heatIgnitionSystem.hpp"
+#include "heatSourceSystem.hpp"
 #include "ignitionSystem.hpp"
+#include "profiler.hpp"
+#include "reactionSystem.hpp"
 #include "renderSystem.hpp"
+#include "snapshotSystem.hpp"
 #include "spawnerSystem.hpp"
+#include "staticGeometrySystem.hpp"
+#include "staticLayer.hpp"
+#include "stepController.hpp"
+#include "systemScheduler.hpp"
+#include "threadPool.hpp"
+#include "timerWheel.hpp"
+#include "tripleBuffer.hpp"
 #include "window.hpp"
 #include <array>
+#include <atomic>
+#include <string>
+#include <thread>
 
 ///////////////////////////////////////////////////////////////////////////
 /// Use the shared mini namespace
@@ -26,8 +48,8 @@ using namespace mini;
 class Engine {
     public:
     /////////////////////////////////////////////////////////////////////////
-    /// \brief  Destroy the engine.
-    ~Engine() = default;
+    /// \brief  Destroy the engine, stopping its simulation thread if any.
+    ~Engine();
     //////////////////////////////////////////////////////////////////////
     /// \brief  Deleted copy constructor.
     Engine(const Engine& o) = delete;
@@ -36,7 +58,17 @@ class Engine {
     Engine(Engine&& o) noexcept = delete;
     /////////////////////////////////////////////////////////////////////////
     /// \brief  Construct an engine object using a specific window.
-    explicit Engine(const Window& window);
+    /// \param  window      the window to render into.
+    /// \param  pipelined   run the simulation on its own thread, rendering
+    ///                     the latest published snapshot of the world.
+    /// \param  scenePath   path to a PGM or PPM material map to fill the
+    ///                     play area from, none if empty.
+    /// \param  checkpointPath  path to stream checkpoints of the world to,
+    ///                         none if empty.
+    explicit Engine(
+        const Window& window, const bool& pipelined = false,
+        const std::string& scenePath = "",
+        const std::string& checkpointPath = "");
 
     //////////////////////////////////////////////////////////////////////
     /// \brief  Deleted copy-assignment operator.
@@ -49,6 +81,40 @@ class Engine {
     /// \brief  Tick the engine state. To be called externally by main loop.
     /// \param  deltaTime   the amount of time since last frame.
     void tick(const double& deltaTime);
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the controller deciding how many steps to simulate.
+    /// \note   Owned by the simulation thread while pipelined.
+    /// \return reference to the engine's step controller.
+    [[nodiscard]] StepController& getStepController() noexcept {
+        return m_stepController;
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the allocation counters of each system.
+    /// \note   Only counts allocations when built with TRACK_ALLOCATIONS.
+    /// \return reference to the engine's profiler.
+    [[nodiscard]] const Profiler& getProfiler() const noexcept {
+        return m_profiler;
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the entity recycling counters.
+    /// \return the counters of the engine's entity pool.
+    [[nodiscard]] EntityPool::Stats getEntityPoolStats() const noexcept {
+        return m_entityPool.getStats();
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the system moving particles through the grid.
+    /// \note   Owned by the simulation thread while pipelined.
+    /// \return reference to the engine's collision system.
+    [[nodiscard]] CollisionSystem& getCollisionSystem() noexcept {
+        return m_collision;
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the system spawning particles from faucets/brushes.
+    /// \note   Owned by the simulation thread while pipelined.
+    /// \return reference to the engine's spawner system.
+    [[nodiscard]] SpawnerSystem& getSpawnerSystem() noexcept {
+        return m_spawnerSystem;
+    }
 
     private:
     /////////////////////////////////////////////////////////////////////////
@@ -59,28 +125,58 @@ class Engine {
     /// \brief  Tick the render logic ahead by delta-time.
     /// \param  deltaTime   the amount of time since last frame.
     void renderTick(const double& deltaTime);
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Run the game logic until stopped, on the simulation thread.
+    void simulationLoop();
 
     private:
     ///////////////////////////////////////////////////////////////////////////
     /// Private Members
-    const Window& m_window;     ///< OS level window.
-    double m_accumulator = 0.0; ///< Time left in the accumulator.
+    const Window& m_window;          ///< OS level window.
+    StepController m_stepController; ///< Decides how many steps to take.
+    ThreadPool m_threadPool;         ///< Threads shared by all systems.
+    Profiler m_profiler;             ///< Allocation counters per system.
+    Profiler::Zone& m_fusedZone;     ///< Zone of the fused cleanup.
+    SystemScheduler m_scheduler;     ///< Runs each step's systems.
+    FrameArena m_frameArena;         ///< Scratch memory of a single step.
+    CounterRNG m_rng;                ///< Deterministic random numbers.
     std::array<ecsWorld, 64>
         m_gameWorlds;     ///< World divided into 64 pixel chunks
     ecsWorld m_gameWorld; ///< The ECS world holding game state.
     std::shared_ptr<ParticleComponent* [513][513]>
-        m_particleArray;         ///< Array of particles
+        m_particleArray;        ///< Array of particles
+    OccupancyGrid m_occupancy; ///< Bits marking occupied particle cells.
+    HeatField m_heatField;     ///< Temperature of each particle cell.
+    StaticLayer m_staticLayer; ///< Particles written into the grid once.
+    EntityPool m_entityPool;   ///< Dead particle entities kept for reuse.
+    TimerWheel<FireTimer>
+        m_burnTimers; ///< Schedules when burning particles burn out.
+    TimerWheel<FireTimer>
+        m_fuseTimers;            ///< Schedules when explosives detonate.
     CollisionSystem m_collision; ///< Sort and apply physics events
+    StaticGeometrySystem
+        m_staticGeometry; ///< Moves resting particles in and out of statics.
     CollisionManifoldSystem
         m_manifolds;               ///< Organize and apply collision manifolds.
     SpawnerSystem m_spawnerSystem; ///< Spawns a particle beneath it every tick.
     IgnitionSystem m_igniter;      ///< Ignites flammable particles.
-    BurningSystem m_burner;        ///< Burns on fire components.
-    CombustionSystem m_combuster;  ///< Combusts explosive particles.
+    ReactionSystem m_reactions;    ///< Reacts touching particles.
+    HeatSourceSystem m_heatSources;    ///< Heats the cells of fires.
+    HeatIgnitionSystem m_heatIgnition; ///< Ignites hot particles.
+    BurningSystem m_burner;        ///< Burns-out expired wicks.
+    CombustionSystem m_combuster;  ///< Detonates expired fuses.
     EntityCleanupSystem m_cleanupSystem; ///< Cleans-up out of bounds.
     CollisionCleanupSystem
         m_collisionCleanup; ///< System used to cleanup collision manifolds.
     RenderSystem m_renderSystem; ///< System used to render the game.
+    TripleBuffer<std::vector<GPU_Particle>>
+        m_snapshots; ///< Render snapshots published by the simulation.
+    SnapshotSystem m_snapshotSystem; ///< Publishes render snapshots.
+    CheckpointWriter m_checkpoints;  ///< Streams checkpoints to disk.
+    CheckpointSystem m_checkpointSystem; ///< Captures checkpoint frames.
+    const bool m_pipelined = false;  ///< Simulate on a separate thread.
+    std::atomic_bool m_simulating{ false }; ///< Keep the simulation running.
+    std::thread m_simulationThread;        ///< Thread running the game logic.
 };
 
 #endif // ENGINE_HPP
\ No newline at end of file
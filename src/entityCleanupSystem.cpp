@@ -5,8 +5,10 @@
 /// Custom Constructor
 //////////////////////////////////////////////////////////////////////
 
-EntityCleanupSystem::EntityCleanupSystem(ecsWorld& gameWorld)
-    : m_gameWorld(gameWorld) {
+EntityCleanupSystem::EntityCleanupSystem(
+    ecsWorld& gameWorld, FrameArena& frameArena, EntityPool& entityPool)
+    : m_gameWorld(gameWorld), m_frameArena(frameArena),
+      m_entityPool(entityPool) {
     addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
 }
 
@@ -17,10 +19,10 @@ EntityCleanupSystem::EntityCleanupSystem(ecsWorld& gameWorld)
 void EntityCleanupSystem::updateComponents(
     const double& /*deltaTime*/,
     const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
-    std::vector<EntityHandle> entitiesToDelete;
-    for (const auto& components : entityComponents) {
-        const auto& particleComponent =
-            *static_cast<ParticleComponent*>(components[0]);
+    ArenaVector<EntityHandle> entitiesToDelete{ ArenaAllocator<EntityHandle>(
+        m_frameArena) };
+    for (const auto [particleComponent] :
+         ComponentView<ParticleComponent>(entityComponents)) {
         const auto& position = particleComponent.m_pos;
 
         // Find entities that are out-of-bounds
@@ -33,7 +35,7 @@ void EntityCleanupSystem::updateComponents(
             entitiesToDelete.emplace_back(particleComponent.m_entityHandle);
     }
 
-    // Remove all out-of-bounds entities
+    // Remove all out-of-bounds entities, keeping plain ones for reuse
     for (const auto& handle : entitiesToDelete)
-        m_gameWorld.removeEntity(handle);
+        m_entityPool.release(handle);
 }
\ No newline at end of file
@@ -2,9 +2,12 @@
 #ifndef ENTITYCLEANUPSYSTEM_HPP
 #define ENTITYCLEANUPSYSTEM_HPP
 
+#include "componentView.hpp"
 #include "components.hpp"
 #include "ecsSystem.hpp"
 #include "ecsWorld.hpp"
+#include "entityPool.hpp"
+#include "frameArena.hpp"
 
 ///////////////////////////////////////////////////////////////////////////
 /// Use the shared mini namespace
@@ -18,7 +21,10 @@ class EntityCleanupSystem final : public ecsSystem {
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Construct a cleanup system.
     /// \param  gameWorld   reference to the engine's game world.
-    explicit EntityCleanupSystem(ecsWorld& gameWorld);
+    /// \param  frameArena  arena holding this step's scratch data.
+    /// \param  entityPool  pool to release dead entities into.
+    EntityCleanupSystem(
+        ecsWorld& gameWorld, FrameArena& frameArena, EntityPool& entityPool);
 
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Tick this system by deltaTime.
@@ -31,6 +37,8 @@ class EntityCleanupSystem final : public ecsSystem {
 
     private:
     ecsWorld& m_gameWorld;
+    FrameArena& m_frameArena;
+    EntityPool& m_entityPool;
 };
 
 #endif // ENTITYCLEANUPSYSTEM_HPP
\ No newline at end of file
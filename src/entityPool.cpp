@@ -0,0 +1,130 @@
+#include "entityPool.hpp"
+#include "profiler.hpp"
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Count the heap allocations a function makes, as attributed to
+///         the calling thread's profiler zone.
+/// \param  func    the function to run.
+/// \return the number of allocations, always 0 without TRACK_ALLOCATIONS.
+template <typename Func> static size_t countAllocations(Func&& func) {
+    auto* zone = Profiler::currentZone();
+    if (!Profiler::tracksAllocations || zone == nullptr) {
+        func();
+        return 0ULL;
+    }
+    const auto before = zone->totalAllocations.load(std::memory_order_relaxed);
+    func();
+    return zone->totalAllocations.load(std::memory_order_relaxed) - before;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+EntityPool::EntityPool(ecsWorld& gameWorld, const size_t& capacity)
+    : m_gameWorld(gameWorld), m_capacity(capacity) {
+    m_dormant.reserve(m_capacity);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// spawn
+//////////////////////////////////////////////////////////////////////
+
+void EntityPool::spawn(const ParticleComponent& particle) {
+    if (!m_dormant.empty()) {
+        const auto handle = m_dormant.back();
+        m_dormant.pop_back();
+        m_reuseAllocations += countAllocations(
+            [&] { m_gameWorld.makeComponent(handle, &particle); });
+        ++m_stats.reused;
+        return;
+    }
+
+    m_createAllocations += countAllocations([&] {
+        const auto handle = m_gameWorld.makeEntity();
+        m_gameWorld.makeComponent(handle, &particle);
+    });
+    ++m_stats.created;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// release
+//////////////////////////////////////////////////////////////////////
+
+void EntityPool::release(const EntityHandle& handle) {
+    // Only plain particles are safe to reuse, others may have timers pending
+    const auto entity = m_gameWorld.getEntity(handle);
+    bool reactive = false;
+    if (entity) {
+        if constexpr (useStateFlags) {
+            const auto particleComponent = static_cast<ParticleComponent*>(
+                m_gameWorld.getComponent<ParticleComponent>(*entity));
+            reactive = particleComponent != nullptr &&
+                       (particleComponent->m_state &
+                        (ParticleComponent::FLAMMABLE |
+                         ParticleComponent::EXPLOSIVE |
+                         ParticleComponent::BURNING)) != 0U;
+        } else
+            reactive =
+                m_gameWorld.getComponent<FlammableComponent>(*entity) ||
+                m_gameWorld.getComponent<ExplosiveComponent>(*entity);
+    }
+    if (!entity || reactive || m_dormant.size() >= m_capacity ||
+        m_gameWorld.getComponent<SpawnerComponent>(*entity)) {
+        m_destroyAllocations +=
+            countAllocations([&] { m_gameWorld.removeEntity(handle); });
+        ++m_stats.destroyed;
+        return;
+    }
+
+    // Strip the entity so no system visits it while dormant
+    m_retireAllocations += countAllocations([&] {
+        m_gameWorld.removeComponent<ParticleComponent>(handle);
+        m_gameWorld.removeComponent<CollisionManifoldComponent>(handle);
+        if constexpr (useStateFlags) {
+            // Spent fire components stay attached while flags track state
+            m_gameWorld.removeComponent<FlammableComponent>(handle);
+            m_gameWorld.removeComponent<ExplosiveComponent>(handle);
+        }
+    });
+    m_dormant.emplace_back(handle);
+    ++m_stats.retired;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// clear
+//////////////////////////////////////////////////////////////////////
+
+void EntityPool::clear() {
+    for (const auto& handle : m_dormant)
+        m_gameWorld.removeEntity(handle);
+    m_stats.destroyed += m_dormant.size();
+    m_dormant.clear();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// getStats
+//////////////////////////////////////////////////////////////////////
+
+EntityPool::Stats EntityPool::getStats() const noexcept {
+    auto stats = m_stats;
+    stats.dormant = m_dormant.size();
+
+    // Compare what recycling cost against the mean cost of the full path
+    const auto avoided = [](const size_t& count, const size_t& fullTotal,
+                            const size_t& fullCount,
+                            const size_t& cost) -> size_t {
+        if (fullCount == 0ULL)
+            return 0ULL;
+        const auto saved = count * fullTotal / fullCount;
+        return saved > cost ? saved - cost : 0ULL;
+    };
+    stats.avoidedAllocations =
+        avoided(
+            m_stats.reused, m_createAllocations, m_stats.created,
+            m_reuseAllocations) +
+        avoided(
+            m_stats.retired, m_destroyAllocations, m_stats.destroyed,
+            m_retireAllocations);
+    return stats;
+}
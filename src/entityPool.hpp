@@ -0,0 +1,83 @@
+#pragma once
+#ifndef ENTITYPOOL_HPP
+#define ENTITYPOOL_HPP
+
+#include "components.hpp"
+#include "ecsWorld.hpp"
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  EntityPool
+/// \brief  Recycles dead particle entities for new spawns. Released plain
+///         particles are stripped of their components and kept dormant,
+///         so spawning re-attaches a particle to a kept entity instead of
+///         creating one. Entities that are flammable, explosive or spawners
+///         may still have timers referring to them, so they are removed.
+///         Only used by systems writing the world's entities, so a single
+///         system touches the pool at a time.
+class EntityPool {
+    public:
+    /////////////////////////////////////////////////////////////////////////
+    /// \struct Stats
+    /// \brief  Counters describing how often entities were recycled.
+    struct Stats {
+        size_t created = 0ULL;   ///< Spawns that made a new entity.
+        size_t reused = 0ULL;    ///< Spawns that reused a dormant entity.
+        size_t retired = 0ULL;   ///< Releases kept as dormant entities.
+        size_t destroyed = 0ULL; ///< Releases that removed the entity.
+        size_t dormant = 0ULL;   ///< Entities currently kept dormant.
+        size_t avoidedAllocations =
+            0ULL; ///< Heap allocations saved, with TRACK_ALLOCATIONS only.
+
+        /////////////////////////////////////////////////////////////////////
+        /// \brief  Retrieve the fraction of spawns that reused an entity.
+        /// \return the reuse rate, between 0 and 1.
+        [[nodiscard]] double reuseRate() const noexcept {
+            const auto spawns = created + reused;
+            return spawns == 0ULL ? 0.0
+                                  : static_cast<double>(reused) /
+                                        static_cast<double>(spawns);
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a pool.
+    /// \param  gameWorld   reference to the engine's game world.
+    /// \param  capacity    the most dormant entities to keep.
+    explicit EntityPool(ecsWorld& gameWorld, const size_t& capacity = 65536ULL);
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Spawn a particle, reusing a dormant entity if there is one.
+    /// \param  particle    the particle component to attach.
+    void spawn(const ParticleComponent& particle);
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Release a dead entity, keeping it dormant if possible.
+    /// \param  handle  handle to the entity to release.
+    void release(const EntityHandle& handle);
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Remove every dormant entity from the world.
+    void clear();
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the pool's counters.
+    /// \return the counters since construction.
+    [[nodiscard]] Stats getStats() const noexcept;
+
+    private:
+    /////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    ecsWorld& m_gameWorld;
+    size_t m_capacity = 0ULL;            ///< Most dormant entities to keep.
+    std::vector<EntityHandle> m_dormant; ///< Entities without components.
+    Stats m_stats;                       ///< Recycling counters.
+    size_t m_createAllocations = 0ULL;   ///< Allocations of new entities.
+    size_t m_reuseAllocations = 0ULL;    ///< Allocations of reused entities.
+    size_t m_destroyAllocations = 0ULL;  ///< Allocations of removals.
+    size_t m_retireAllocations = 0ULL;   ///< Allocations of retirements.
+};
+
+#endif // ENTITYPOOL_HPP
@@ -0,0 +1,58 @@
+#include "frameArena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+FrameArena::FrameArena(const size_t& capacity)
+    : m_block(std::make_unique<std::byte[]>(capacity)),
+      m_capacity(capacity) {}
+
+//////////////////////////////////////////////////////////////////////
+/// allocate
+//////////////////////////////////////////////////////////////////////
+
+void* FrameArena::allocate(const size_t& bytes, const size_t& alignment) {
+    // Reserve enough to align the result wherever the offset lands
+    const auto padded = bytes + alignment - 1ULL;
+    const auto offset = m_offset.fetch_add(padded, std::memory_order_relaxed);
+    if (offset + padded <= m_capacity) {
+        const auto address = reinterpret_cast<std::uintptr_t>(m_block.get());
+        const auto aligned =
+            (address + offset + alignment - 1ULL) & ~(alignment - 1ULL);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // Spill into a block of its own, freed at the next reset
+    const std::lock_guard<std::mutex> lock(m_overflowMutex);
+    auto& block =
+        m_overflow.emplace_back(std::make_unique<std::byte[]>(padded));
+    const auto address = reinterpret_cast<std::uintptr_t>(block.get());
+    return reinterpret_cast<void*>(
+        (address + alignment - 1ULL) & ~(alignment - 1ULL));
+}
+
+//////////////////////////////////////////////////////////////////////
+/// reset
+//////////////////////////////////////////////////////////////////////
+
+void FrameArena::reset() {
+    // Grow to the last step's peak so the next one fits in a single block
+    const auto peak = m_offset.exchange(0ULL, std::memory_order_relaxed);
+    if (!m_overflow.empty()) {
+        m_overflow.clear();
+        m_capacity = std::max<size_t>(peak, m_capacity * 2ULL);
+        m_block = std::make_unique<std::byte[]>(m_capacity);
+        ++m_growthCount;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// getUsed
+//////////////////////////////////////////////////////////////////////
+
+size_t FrameArena::getUsed() const noexcept {
+    return m_offset.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,121 @@
+#pragma once
+#ifndef FRAMEARENA_HPP
+#define FRAMEARENA_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  FrameArena
+/// \brief  Monotonic allocator for scratch data living a single step.
+///         Allocations bump an atomic offset into one block and are never
+///         freed individually; the whole arena is released by reset() at
+///         the top of each step. Requests that don't fit spill into
+///         overflow blocks, and the next reset grows the main block to the
+///         step's peak, so steady-state steps make no heap allocations.
+class FrameArena {
+    public:
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct an arena.
+    /// \param  capacity    the initial size of the main block in bytes.
+    explicit FrameArena(const size_t& capacity = 1ULL << 20ULL);
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Allocate memory valid until the next reset, thread-safe.
+    /// \param  bytes       the size of the allocation.
+    /// \param  alignment   the alignment of the allocation.
+    /// \return pointer to the allocated memory.
+    [[nodiscard]] void* allocate(const size_t& bytes, const size_t& alignment);
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Release every allocation, growing the main block if the last
+    ///         step overflowed it. Must not race with allocate().
+    void reset();
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the bytes handed out since the last reset.
+    /// \return the bytes in use, including alignment padding.
+    [[nodiscard]] size_t getUsed() const noexcept;
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the size of the main block.
+    /// \return the capacity in bytes.
+    [[nodiscard]] size_t getCapacity() const noexcept { return m_capacity; }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve how many resets had to grow the main block.
+    /// \return the number of times the arena grew.
+    [[nodiscard]] size_t getGrowthCount() const noexcept {
+        return m_growthCount;
+    }
+
+    private:
+    /////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    std::unique_ptr<std::byte[]> m_block; ///< The main block.
+    size_t m_capacity = 0ULL;             ///< Size of the main block.
+    std::atomic<size_t> m_offset{ 0ULL }; ///< Bytes used, may pass capacity.
+    std::mutex m_overflowMutex;           ///< Guards the overflow blocks.
+    std::vector<std::unique_ptr<std::byte[]>>
+        m_overflow;             ///< Blocks for requests past the main block.
+    size_t m_growthCount = 0ULL; ///< Number of resets that grew the arena.
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  ArenaAllocator
+/// \brief  Standard allocator drawing from a frame arena, for containers
+///         of per-step scratch data. Deallocation is a no-op.
+template <typename T> class ArenaAllocator {
+    public:
+    using value_type = T;
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct an allocator drawing from an arena.
+    /// \param  arena   the arena to draw from.
+    explicit ArenaAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Rebind an allocator to another type.
+    /// \param  other   the allocator to copy the arena from.
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : m_arena(other.getArena()) {}
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Allocate space for a number of elements.
+    /// \param  count   the number of elements.
+    /// \return pointer to the uninitialized elements.
+    [[nodiscard]] T* allocate(const size_t count) {
+        return static_cast<T*>(
+            m_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Does nothing, the arena is released as a whole.
+    void deallocate(T* /*pointer*/, const size_t /*count*/) noexcept {}
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the arena this allocator draws from.
+    /// \return pointer to the arena.
+    [[nodiscard]] FrameArena* getArena() const noexcept { return m_arena; }
+
+    private:
+    FrameArena* m_arena = nullptr; ///< The arena to draw from.
+};
+
+template <typename T, typename U>
+bool operator==(
+    const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.getArena() == b.getArena();
+}
+template <typename T, typename U>
+bool operator!=(
+    const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return !(a == b);
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \brief  A vector of per-step scratch data, backed by a frame arena.
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // FRAMEARENA_HPP
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef GUARDBAND_HPP
+#define GUARDBAND_HPP
+
+///////////////////////////////////////////////////////////////////////////
+/// Layout of the particle grid: a playable area ringed by a one cell guard
+/// band of immovable walls, padded out to 513 cells a side. Every cell a
+/// particle can reach has all 8 neighbours within the grid, so neighbour
+/// kernels index them without bounds checks.
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The lowest row and column particles may occupy.
+constexpr int playMin = 1;
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The highest row and column particles may occupy.
+constexpr int playMax = 510;
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The far row and column of the guard band, past it is padding.
+constexpr int guardMax = playMax + 1;
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Check if a cell lies inside the guard band.
+/// \param  x   the cell's column.
+/// \param  y   the cell's row.
+/// \return true if particles may occupy the cell.
+[[nodiscard]] constexpr bool inPlayArea(const int& x, const int& y) noexcept {
+    return x >= playMin && x <= playMax && y >= playMin && y <= playMax;
+}
+
+#endif // GUARDBAND_HPP
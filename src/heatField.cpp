@@ -0,0 +1,213 @@
+#include "heatField.hpp"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////
+/// Furthest a chunk's cells may be from ambient for it to fall asleep
+constexpr float settledDelta = 0.01F;
+//////////////////////////////////////////////////////////////////////
+/// Largest stencil rate the explicit scheme stays stable at
+constexpr float stableRate = 0.25F;
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Apply the 5-point stencil along a run of a row.
+///         Four cells at a time where SSE2 is available, the sums taken in
+///         the same order either way so both match the scalar reference.
+/// \param  up      the run's cells in the row above.
+/// \param  row     the run's cells, with a readable cell either side.
+/// \param  down    the run's cells in the row below.
+/// \param  out     the run's cells in the next buffer.
+/// \param  count   the number of cells in the run.
+/// \param  rate    the fraction of the neighbours' difference taken.
+/// \param  ambient the temperature of cells left alone.
+/// \return the furthest any new cell is from ambient.
+static float diffuseRun(
+    const float* __restrict up, const float* __restrict row,
+    const float* __restrict down, float* __restrict out, const int& count,
+    const float& rate, const float& ambient) noexcept {
+    int x = 0;
+    float deviation = 0.0F;
+#if defined(__SSE2__) || defined(_M_X64)
+    const __m128 rates = _mm_set1_ps(rate);
+    const __m128 fours = _mm_set1_ps(4.0F);
+    const __m128 ambients = _mm_set1_ps(ambient);
+    const __m128 signs = _mm_set1_ps(-0.0F);
+    __m128 deviations = _mm_setzero_ps();
+    for (; x + 4 <= count; x += 4) {
+        const __m128 center = _mm_loadu_ps(row + x);
+        const __m128 sum = _mm_add_ps(
+            _mm_add_ps(_mm_loadu_ps(up + x), _mm_loadu_ps(down + x)),
+            _mm_add_ps(_mm_loadu_ps(row + x - 1), _mm_loadu_ps(row + x + 1)));
+        const __m128 value = _mm_add_ps(
+            center,
+            _mm_mul_ps(rates, _mm_sub_ps(sum, _mm_mul_ps(fours, center))));
+        _mm_storeu_ps(out + x, value);
+        deviations = _mm_max_ps(
+            deviations, _mm_andnot_ps(signs, _mm_sub_ps(value, ambients)));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, deviations);
+    deviation = std::max(
+        std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+    for (; x < count; ++x) {
+        const float sum = (up[x] + down[x]) + (row[x - 1] + row[x + 1]);
+        out[x] = row[x] + rate * (sum - 4.0F * row[x]);
+        deviation = std::max(deviation, std::fabs(out[x] - ambient));
+    }
+    return deviation;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+HeatField::HeatField(const int& width, const int& height, const float& ambient)
+    : m_width(width), m_height(height),
+      m_chunksX((width + CHUNK - 1) / CHUNK),
+      m_chunksY((height + CHUNK - 1) / CHUNK),
+      m_stride(static_cast<size_t>(width) + 2ULL), m_ambient(ambient),
+      m_current(m_stride * (static_cast<size_t>(height) + 2ULL), ambient),
+      m_next(m_current),
+      m_active(static_cast<size_t>(m_chunksX * m_chunksY), 0U),
+      m_update(m_active) {}
+
+//////////////////////////////////////////////////////////////////////
+/// add
+//////////////////////////////////////////////////////////////////////
+
+void HeatField::add(const int& x, const int& y, const float& amount) noexcept {
+    m_current[index(x, y)] += amount;
+    wake(x, y);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// raise
+//////////////////////////////////////////////////////////////////////
+
+void HeatField::raise(
+    const int& x, const int& y, const float& temperature) noexcept {
+    auto& cell = m_current[index(x, y)];
+    cell = std::max(cell, temperature);
+    wake(x, y);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// diffuse
+//////////////////////////////////////////////////////////////////////
+
+void HeatField::diffuse(const float& deltaTime, ThreadPool& threadPool) {
+    // Heat only crosses into a chunk through an edge it shares
+    m_activeChunks = 0ULL;
+    for (int chunkY = 0; chunkY < m_chunksY; ++chunkY) {
+        for (int chunkX = 0; chunkX < m_chunksX; ++chunkX) {
+            const auto active = [&](const int& cx, const int& cy) {
+                return cx >= 0 && cx < m_chunksX && cy >= 0 && cy < m_chunksY &&
+                       m_active[static_cast<size_t>(cy * m_chunksX + cx)] != 0U;
+            };
+            const bool update =
+                active(chunkX, chunkY) || active(chunkX - 1, chunkY) ||
+                active(chunkX + 1, chunkY) || active(chunkX, chunkY - 1) ||
+                active(chunkX, chunkY + 1);
+            m_update[static_cast<size_t>(chunkY * m_chunksX + chunkX)] =
+                update ? 1U : 0U;
+            m_activeChunks += update ? 1ULL : 0ULL;
+        }
+    }
+    if (m_activeChunks == 0ULL)
+        return;
+
+    // Diffuse each chunk row's chunks on its own thread
+    const auto rate = stepRate(deltaTime);
+    threadPool.parallelFor(
+        0ULL, static_cast<size_t>(m_chunksY), 1ULL,
+        [&](const size_t& begin, const size_t& end) {
+            for (auto chunkY = static_cast<int>(begin);
+                 chunkY < static_cast<int>(end); ++chunkY)
+                for (int chunkX = 0; chunkX < m_chunksX; ++chunkX) {
+                    const auto chunk =
+                        static_cast<size_t>(chunkY * m_chunksX + chunkX);
+                    if (m_update[chunk] != 0U)
+                        m_active[chunk] =
+                            diffuseChunk(chunkX, chunkY, rate) ? 1U : 0U;
+                }
+        });
+
+    // Snap chunks that cooled off to exactly ambient in both buffers, once
+    // no other chunk still reads their edges
+    threadPool.parallelFor(
+        0ULL, static_cast<size_t>(m_chunksY), 1ULL,
+        [&](const size_t& begin, const size_t& end) {
+            for (auto chunkY = static_cast<int>(begin);
+                 chunkY < static_cast<int>(end); ++chunkY)
+                for (int chunkX = 0; chunkX < m_chunksX; ++chunkX) {
+                    const auto chunk =
+                        static_cast<size_t>(chunkY * m_chunksX + chunkX);
+                    if (m_update[chunk] == 0U || m_active[chunk] != 0U)
+                        continue;
+                    const int x = chunkX * CHUNK;
+                    const auto count = static_cast<size_t>(
+                        std::min(CHUNK, m_width - x));
+                    const int lastY = std::min((chunkY + 1) * CHUNK, m_height);
+                    for (int y = chunkY * CHUNK; y < lastY; ++y) {
+                        std::fill_n(&m_current[index(x, y)], count, m_ambient);
+                        std::fill_n(&m_next[index(x, y)], count, m_ambient);
+                    }
+                }
+        });
+    m_current.swap(m_next);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// diffuseReference
+//////////////////////////////////////////////////////////////////////
+
+void HeatField::diffuseReference(const float& deltaTime) {
+    const auto rate = stepRate(deltaTime);
+    for (int y = 0; y < m_height; ++y) {
+        for (int x = 0; x < m_width; ++x) {
+            const float sum = (m_current[index(x, y - 1)] +
+                               m_current[index(x, y + 1)]) +
+                              (m_current[index(x - 1, y)] +
+                               m_current[index(x + 1, y)]);
+            const float center = m_current[index(x, y)];
+            m_next[index(x, y)] = center + rate * (sum - 4.0F * center);
+        }
+    }
+    m_current.swap(m_next);
+
+    // Every chunk may have changed, leave the chunked kernel to sort it out
+    std::fill(m_active.begin(), m_active.end(), 1U);
+    m_activeChunks = m_active.size();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// diffuseChunk
+//////////////////////////////////////////////////////////////////////
+
+bool HeatField::diffuseChunk(
+    const int& chunkX, const int& chunkY, const float& rate) {
+    const int x = chunkX * CHUNK;
+    const int count = std::min(CHUNK, m_width - x);
+    const int lastY = std::min((chunkY + 1) * CHUNK, m_height);
+    float deviation = 0.0F;
+    for (int y = chunkY * CHUNK; y < lastY; ++y)
+        deviation = std::max(
+            deviation,
+            diffuseRun(
+                &m_current[index(x, y - 1)], &m_current[index(x, y)],
+                &m_current[index(x, y + 1)], &m_next[index(x, y)], count,
+                rate, m_ambient));
+    return deviation > settledDelta;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// stepRate
+//////////////////////////////////////////////////////////////////////
+
+float HeatField::stepRate(const float& deltaTime) const noexcept {
+    return std::min(m_diffusivity * deltaTime, stableRate);
+}
@@ -0,0 +1,134 @@
+#pragma once
+#ifndef HEATFIELD_HPP
+#define HEATFIELD_HPP
+
+#include "threadPool.hpp"
+#include <cstdint>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  HeatField
+/// \brief  A temperature per grid cell, diffused each step by a 5-point
+///         stencil. Cells are grouped into square chunks, and only chunks
+///         that are warmer or colder than ambient, or border one that is,
+///         are diffused; the rest hold ambient exactly. Rows are padded by
+///         a ring of ambient cells, so the stencil never checks bounds.
+class HeatField {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  The number of cells along each side of a chunk.
+    static constexpr int CHUNK = 64;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a field at ambient temperature.
+    /// \param  width   the number of columns.
+    /// \param  height  the number of rows.
+    /// \param  ambient the temperature of cells left alone.
+    HeatField(
+        const int& width, const int& height, const float& ambient = 20.0F);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the temperature of a cell.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    /// \return the cell's temperature.
+    [[nodiscard]] float get(const int& x, const int& y) const noexcept {
+        return m_current[index(x, y)];
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Add heat to a cell, waking its chunk.
+    /// \param  x       the cell's column.
+    /// \param  y       the cell's row.
+    /// \param  amount  the change in temperature, negative to cool.
+    void add(const int& x, const int& y, const float& amount) noexcept;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Raise a cell to at least a temperature, waking its chunk.
+    /// \param  x           the cell's column.
+    /// \param  y           the cell's row.
+    /// \param  temperature the lowest temperature the cell may have.
+    void raise(const int& x, const int& y, const float& temperature) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Diffuse heat through the active chunks, in parallel.
+    /// \param  deltaTime   the duration of a step.
+    /// \param  threadPool  the threads to diffuse chunk rows on.
+    void diffuse(const float& deltaTime, ThreadPool& threadPool);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Diffuse heat through every cell, one at a time. Slow, kept as
+    ///         the reference the chunked kernel is checked against.
+    /// \param  deltaTime   the duration of a step.
+    void diffuseReference(const float& deltaTime);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Set how fast heat spreads.
+    /// \param  diffusivity the diffusivity in cells squared per second.
+    void setDiffusivity(const float& diffusivity) noexcept {
+        m_diffusivity = diffusivity;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the temperature of cells left alone.
+    /// \return the ambient temperature.
+    [[nodiscard]] float getAmbient() const noexcept { return m_ambient; }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of chunks diffused by the last step.
+    /// \return the number of chunks diffused.
+    [[nodiscard]] size_t getActiveChunks() const noexcept {
+        return m_activeChunks;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of columns.
+    /// \return the field's width.
+    [[nodiscard]] int getWidth() const noexcept { return m_width; }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of rows.
+    /// \return the field's height.
+    [[nodiscard]] int getHeight() const noexcept { return m_height; }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Find a cell within the padded rows.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    /// \return the cell's index into either buffer.
+    [[nodiscard]] size_t index(const int& x, const int& y) const noexcept {
+        return static_cast<size_t>(y + 1) * m_stride +
+               static_cast<size_t>(x + 1);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Mark the chunk holding a cell as active.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    void wake(const int& x, const int& y) noexcept {
+        m_active[static_cast<size_t>((y / CHUNK) * m_chunksX + x / CHUNK)] =
+            1U;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Diffuse a single chunk into the next buffer.
+    /// \param  chunkX  the chunk's column.
+    /// \param  chunkY  the chunk's row.
+    /// \param  rate    the fraction of the neighbours' difference taken.
+    /// \return true if any of the chunk's cells ended away from ambient.
+    bool diffuseChunk(const int& chunkX, const int& chunkY, const float& rate);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Compute the stencil's rate for a step, clamped to stay stable.
+    /// \param  deltaTime   the duration of a step.
+    /// \return the fraction of the neighbours' difference taken per step.
+    [[nodiscard]] float stepRate(const float& deltaTime) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    int m_width = 0;              ///< Number of columns.
+    int m_height = 0;             ///< Number of rows.
+    int m_chunksX = 0;            ///< Number of chunk columns.
+    int m_chunksY = 0;            ///< Number of chunk rows.
+    size_t m_stride = 0ULL;       ///< Floats per padded row.
+    float m_ambient = 20.0F;      ///< Temperature of cells left alone.
+    float m_diffusivity = 8.0F;   ///< Cells squared per second.
+    size_t m_activeChunks = 0ULL; ///< Chunks diffused by the last step.
+    std::vector<float> m_current; ///< This step's temperatures.
+    std::vector<float> m_next;    ///< The temperatures being computed.
+    std::vector<std::uint8_t> m_active; ///< Chunks away from ambient.
+    std::vector<std::uint8_t> m_update; ///< Chunks to diffuse this step.
+};
+
+#endif // HEATFIELD_HPP
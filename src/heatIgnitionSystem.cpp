@@ -0,0 +1,54 @@
+#include "heatIgnitionSystem.hpp"
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+HeatIgnitionSystem::HeatIgnitionSystem(
+    ecsWorld& gameWorld, const HeatField& heatField, IgnitionSystem& igniter,
+    FrameArena& frameArena)
+    : m_gameWorld(gameWorld), m_heatField(heatField), m_igniter(igniter),
+      m_frameArena(frameArena) {
+    addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
+    addComponentType(
+        FlammableComponent::Runtime_ID, RequirementsFlag::REQUIRED);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// updateComponents
+//////////////////////////////////////////////////////////////////////
+
+void HeatIgnitionSystem::updateComponents(
+    const double& deltaTime,
+    const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
+    // Find flammable particles whose cell got hot enough to catch fire
+    ArenaVector<EntityHandle> ignitions{ ArenaAllocator<EntityHandle>(
+        m_frameArena) };
+    for (const auto [particleComponent, flammableComponent] :
+         ComponentView<ParticleComponent, FlammableComponent>(
+             entityComponents)) {
+        if ((particleComponent.m_state & (ParticleComponent::FLAMMABLE |
+                                          ParticleComponent::BURNING)) !=
+            ParticleComponent::FLAMMABLE)
+            continue;
+        const auto temperature = m_heatField.get(
+            static_cast<int>(particleComponent.m_pos.x()),
+            static_cast<int>(particleComponent.m_pos.y()));
+        if (temperature >= flammableComponent.ignitionPoint)
+            ignitions.emplace_back(particleComponent.m_entityHandle);
+    }
+
+    // Igniting adds components, so only once done iterating them
+    for (const auto& handle : ignitions) {
+        const auto entity = m_gameWorld.getEntity(handle);
+        if (!entity)
+            continue;
+        const auto particleComponent = static_cast<ParticleComponent*>(
+            m_gameWorld.getComponent<ParticleComponent>(*entity));
+        const auto flammableComponent = static_cast<FlammableComponent*>(
+            m_gameWorld.getComponent<FlammableComponent>(*entity));
+        if (particleComponent != nullptr && flammableComponent != nullptr)
+            m_igniter.ignite(
+                *entity, *particleComponent, *flammableComponent, deltaTime);
+    }
+}
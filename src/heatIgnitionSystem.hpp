@@ -0,0 +1,52 @@
+#pragma once
+#ifndef HEATIGNITIONSYSTEM_HPP
+#define HEATIGNITIONSYSTEM_HPP
+
+#include "componentView.hpp"
+#include "components.hpp"
+#include "ecsSystem.hpp"
+#include "ecsWorld.hpp"
+#include "frameArena.hpp"
+#include "heatField.hpp"
+#include "ignitionSystem.hpp"
+
+///////////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  HeatIgnitionSystem
+/// \brief  System setting flammable particles on fire once their cell of
+///         the heat field reached their ignition point, without them
+///         having to touch a flame.
+class HeatIgnitionSystem final : public ecsSystem {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a heat ignition system.
+    /// \param  gameWorld   reference to the engine's game world.
+    /// \param  heatField   the temperature of each grid cell.
+    /// \param  igniter     the system setting particles on fire.
+    /// \param  frameArena  arena holding this step's scratch data.
+    HeatIgnitionSystem(
+        ecsWorld& gameWorld, const HeatField& heatField,
+        IgnitionSystem& igniter, FrameArena& frameArena);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Tick this system by deltaTime.
+    /// \param	deltaTime	    the amount of time passed since last update.
+    /// \param	components	    the components to update.
+    void updateComponents(
+        const double& deltaTime,
+        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
+        final;
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    ecsWorld& m_gameWorld;
+    const HeatField& m_heatField;
+    IgnitionSystem& m_igniter;
+    FrameArena& m_frameArena;
+};
+
+#endif // HEATIGNITIONSYSTEM_HPP
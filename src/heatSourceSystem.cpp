@@ -0,0 +1,31 @@
+#include "heatSourceSystem.hpp"
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+HeatSourceSystem::HeatSourceSystem(HeatField& heatField)
+    : m_heatField(heatField) {
+    addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
+    addComponentType(
+        FlammableComponent::Runtime_ID, RequirementsFlag::REQUIRED);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// updateComponents
+//////////////////////////////////////////////////////////////////////
+
+void HeatSourceSystem::updateComponents(
+    const double& /*deltaTime*/,
+    const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
+    // Fires heat their own cell
+    for (const auto [particleComponent, flammableComponent] :
+         ComponentView<ParticleComponent, FlammableComponent>(
+             entityComponents)) {
+        if ((particleComponent.m_state & ParticleComponent::BURNING) != 0U)
+            m_heatField.raise(
+                static_cast<int>(particleComponent.m_pos.x()),
+                static_cast<int>(particleComponent.m_pos.y()),
+                flammableComponent.flameTemperature);
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef HEATSOURCESYSTEM_HPP
+#define HEATSOURCESYSTEM_HPP
+
+#include "componentView.hpp"
+#include "components.hpp"
+#include "ecsSystem.hpp"
+#include "heatField.hpp"
+
+///////////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  HeatSourceSystem
+/// \brief  System feeding the heat of fires into the heat field, each
+///         burning particle holding its cell at its flame temperature.
+class HeatSourceSystem final : public ecsSystem {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a heat source system.
+    /// \param  heatField   the temperature of each grid cell.
+    explicit HeatSourceSystem(HeatField& heatField);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Tick this system by deltaTime.
+    /// \param	deltaTime	    the amount of time passed since last update.
+    /// \param	components	    the components to update.
+    void updateComponents(
+        const double& deltaTime,
+        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
+        final;
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    HeatField& m_heatField;
+};
+
+#endif // HEATSOURCESYSTEM_HPP
@@ -1,32 +1,51 @@
 #include "ignitionSystem.hpp"
+#include <cmath>
 
 //////////////////////////////////////////////////////////////////////
 /// Custom Constructor
 //////////////////////////////////////////////////////////////////////
 
-IgnitionSystem::IgnitionSystem(ecsWorld& gameWorld) : m_gameWorld(gameWorld) {
-    addComponentType(
-        CollisionManifoldComponent::Runtime_ID, RequirementsFlag::REQUIRED);
-    addComponentType(OnFireComponent::Runtime_ID, RequirementsFlag::REQUIRED);
-}
+IgnitionSystem::IgnitionSystem(
+    ecsWorld& gameWorld, TimerWheel<FireTimer>& burnTimers,
+    TimerWheel<FireTimer>& fuseTimers)
+    : m_gameWorld(gameWorld), m_burnTimers(burnTimers),
+      m_fuseTimers(fuseTimers) {}
 
 //////////////////////////////////////////////////////////////////////
-/// updateComponents
+/// ignite
 //////////////////////////////////////////////////////////////////////
 
-void IgnitionSystem::updateComponents(
-    const double& /*deltaTime*/,
-    const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
-    for (const auto& components : entityComponents) {
-        const auto collisionManifold =
-            static_cast<CollisionManifoldComponent*>(components.front());
+void IgnitionSystem::ignite(
+    ecsEntity& entity, ParticleComponent& particle,
+    const FlammableComponent& flammable, const double& deltaTime) {
+    const auto toSteps = [&](const float& duration) {
+        return static_cast<size_t>(
+            std::ceil(static_cast<double>(duration) / deltaTime));
+    };
 
-        for (const auto& manifold : collisionManifold->collisions) {
-            if (m_gameWorld.getComponent<FlammableComponent>(
-                    *manifold.otherEntity)) {
-                m_gameWorld.makeComponent<OnFireComponent>(
-                    *manifold.otherEntity);
-            }
-        }
+    // Schedule when this entity burns out, and when it detonates
+    const FireTimer timer{ flammable.m_entityHandle, particle.m_ignition };
+    m_burnTimers.schedule(timer, toSteps(flammable.wickTime));
+    if ((particle.m_state & ParticleComponent::EXPLOSIVE) != 0U) {
+        if (const auto explosiveComponent = static_cast<ExplosiveComponent*>(
+                m_gameWorld.getComponent<ExplosiveComponent>(entity)))
+            m_fuseTimers.schedule(timer, toSteps(explosiveComponent->fuseTime));
     }
-}
\ No newline at end of file
+    particle.m_state |= ParticleComponent::BURNING;
+    if constexpr (!useStateFlags)
+        m_gameWorld.makeComponent<OnFireComponent>(entity);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// extinguish
+//////////////////////////////////////////////////////////////////////
+
+void IgnitionSystem::extinguish(
+    const EntityHandle& handle, ParticleComponent& particle) {
+    // Moving on to the next ignition leaves this one's timers stale, so
+    // they're skipped when they expire rather than searched for now
+    particle.m_state &= static_cast<std::uint8_t>(~ParticleComponent::BURNING);
+    ++particle.m_ignition;
+    if constexpr (!useStateFlags)
+        m_gameWorld.removeComponent<OnFireComponent>(handle);
+}
@@ -3,8 +3,8 @@
 #define IGNITIONSYSTEM_HPP
 
 #include "components.hpp"
-#include "ecsSystem.hpp"
 #include "ecsWorld.hpp"
+#include "timerWheel.hpp"
 
 ///////////////////////////////////////////////////////////////////////////
 /// Use the shared mini namespace
@@ -12,25 +12,43 @@ using namespace mini;
 
 ///////////////////////////////////////////////////////////////////////////
 /// \class  IgnitionSystem
-/// \brief  Class is used to ignite flammable particles
-class IgnitionSystem final : public ecsSystem {
+/// \brief  Class is used to ignite flammable particles, scheduling when
+///         they will burn out and detonate, and to put them out again.
+///         Used by the systems finding what catches fire.
+class IgnitionSystem final {
     public:
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief  Construct a cleanup system.
+    /// \brief  Construct an ignition system.
     /// \param  gameWorld   reference to the engine's game world.
-    explicit IgnitionSystem(ecsWorld& gameWorld);
+    /// \param  burnTimers  timers scheduled for burning entities.
+    /// \param  fuseTimers  timers scheduled for burning explosive entities.
+    IgnitionSystem(
+        ecsWorld& gameWorld, TimerWheel<FireTimer>& burnTimers,
+        TimerWheel<FireTimer>& fuseTimers);
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief  Tick this system by deltaTime.
-    /// \param	deltaTime	    the amount of time passed since last update.
-    /// \param	components	    the components to update.
-    void updateComponents(
-        const double&,
-        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
-        final;
+    /// \brief  Set a flammable entity on fire, scheduling when it will burn
+    ///         out and, if explosive, detonate.
+    /// \param  entity      the entity to ignite, which must not be burning.
+    /// \param  particle    the entity's particle.
+    /// \param  flammable   the entity's flammable component.
+    /// \param  deltaTime   the duration of a step.
+    void ignite(
+        ecsEntity& entity, ParticleComponent& particle,
+        const FlammableComponent& flammable, const double& deltaTime);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Put out a burning entity, which stays flammable. Its pending
+    ///         burn-out and detonation timers no longer apply.
+    /// \param  handle      the entity to put out.
+    /// \param  particle    the entity's particle, which must be burning.
+    void extinguish(const EntityHandle& handle, ParticleComponent& particle);
 
     private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
     ecsWorld& m_gameWorld;
+    TimerWheel<FireTimer>& m_burnTimers;
+    TimerWheel<FireTimer>& m_fuseTimers;
 };
 
-#endif // IGNITIONSYSTEM_HPP
\ No newline at end of file
+#endif // IGNITIONSYSTEM_HPP
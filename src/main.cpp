@@ -6,6 +6,7 @@
 #include <glad/glad.h>
 #include <iostream>
 #include <string>
+#include <vector>
 
 //////////////////////////////////////////////////////////////////////
 /// Forward Declarations
@@ -17,9 +18,22 @@ static void register_debug();
 /// main
 //////////////////////////////////////////////////////////////////////
 
-int main() noexcept {
+int main(int argc, char** argv) noexcept {
     const Window window = init_backend(vec2(512));
-    Engine engine(window);
+    // Optional arguments name a material map to fill the world from, and a
+    // file to stream checkpoints to. --pipelined runs the simulation on its
+    // own thread
+    bool pipelined = false;
+    std::vector<std::string> paths;
+    for (int index = 1; index < argc; ++index) {
+        const std::string argument(argv[index]);
+        if (argument == "--pipelined")
+            pipelined = true;
+        else
+            paths.push_back(argument);
+    }
+    paths.resize(2ULL);
+    Engine engine(window, pipelined, paths[0], paths[1]);
 
     // Main Loop
     double lastTime(0.0);
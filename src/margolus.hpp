@@ -0,0 +1,127 @@
+#pragma once
+#ifndef MARGOLUS_HPP
+#define MARGOLUS_HPP
+
+#include "behaviour.hpp"
+#include "components.hpp"
+#include <array>
+#include <cstdint>
+
+/////////////////////////////////////////////////////////////////////////
+/// \enum   BlockClass
+/// \brief  How a cell behaves within a Margolus block, lightest first.
+enum class BlockClass : std::uint8_t { EMPTY, LIQUID, POWDER, WALL };
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Find the block class of a particle cell.
+/// \param  particle    the cell's particle, or nullptr if empty.
+/// \return the class of the cell.
+inline BlockClass classifyCell(const ParticleComponent* particle) noexcept {
+    if (particle == nullptr)
+        return BlockClass::EMPTY;
+    switch (behaviourOf(*particle)) {
+    case Behaviour::STATIC:
+        return BlockClass::WALL;
+    case Behaviour::POWDER:
+        return BlockClass::POWDER;
+    default:
+        // Blocks have no rising class, gases flow like the lightest liquid
+        return BlockClass::LIQUID;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Check whether a block only holds powder and walls, so stays as
+///         it is until a neighbouring block changes.
+/// \param  state   the class of each cell, cell i in bits (i * 2).
+/// \return true if no cell is empty or liquid.
+constexpr bool isGranularBlock(const std::uint8_t& state) noexcept {
+    for (int cell = 0; cell < 4; ++cell) {
+        const auto cellClass = (state >> (cell * 2)) & 3U;
+        if (cellClass != static_cast<unsigned>(BlockClass::POWDER) &&
+            cellClass != static_cast<unsigned>(BlockClass::WALL))
+            return false;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Compute the next state of a single 2x2 block.
+///         Cells are numbered bottom-left, bottom-right, top-left, top-right.
+///         Tops sink through lighter bottoms, otherwise a top may topple
+///         down the diagonal, otherwise liquids spread sideways.
+/// \param  state       the class of each cell, cell i in bits (i * 2).
+/// \param  preferLeft  true to let the left column topple first.
+/// \return the source cell of each destination cell, in bits (i * 2).
+constexpr std::uint8_t
+margolusRule(const std::uint8_t& state, const bool& preferLeft) noexcept {
+    std::array<std::uint8_t, 4> classes{};
+    std::array<std::uint8_t, 4> sources{ 0U, 1U, 2U, 3U };
+    for (int cell = 0; cell < 4; ++cell)
+        classes[cell] = static_cast<std::uint8_t>((state >> (cell * 2)) & 3U);
+
+    constexpr auto wall = static_cast<std::uint8_t>(BlockClass::WALL);
+    constexpr auto liquid = static_cast<std::uint8_t>(BlockClass::LIQUID);
+    constexpr auto empty = static_cast<std::uint8_t>(BlockClass::EMPTY);
+    const auto trySwap = [&](const int& from, const int& into) {
+        if (classes[from] == wall || classes[into] == wall ||
+            classes[from] <= classes[into])
+            return false;
+        const auto fromClass = classes[from];
+        classes[from] = classes[into];
+        classes[into] = fromClass;
+        const auto fromSource = sources[from];
+        sources[from] = sources[into];
+        sources[into] = fromSource;
+        return true;
+    };
+
+    // Fall, each top sinking through a lighter bottom
+    bool moved = trySwap(2, 0);
+    moved = trySwap(3, 1) || moved;
+
+    // Topple, a resting top sliding down into the other column
+    if (!moved) {
+        if (preferLeft)
+            moved = trySwap(2, 1) || trySwap(3, 0);
+        else
+            moved = trySwap(3, 0) || trySwap(2, 1);
+    }
+
+    // Flow, liquids spreading into empty cells beside them
+    for (int row = 0; row < 4 && !moved; row += 2) {
+        if (classes[row] == liquid && classes[row + 1] == empty)
+            moved = trySwap(row, row + 1);
+        else if (classes[row] == empty && classes[row + 1] == liquid)
+            moved = trySwap(row + 1, row);
+    }
+
+    std::uint8_t result = 0U;
+    for (int cell = 0; cell < 4; ++cell)
+        result |= static_cast<std::uint8_t>(sources[cell] << (cell * 2));
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Precompute the next state of every possible 2x2 block.
+/// \param  preferLeft  true to let the left column topple first.
+/// \return table of source cells, indexed by the class of each cell.
+constexpr std::array<std::uint8_t, 256>
+makeMargolusTable(const bool& preferLeft) noexcept {
+    std::array<std::uint8_t, 256> table{};
+    for (int state = 0; state < 256; ++state)
+        table[state] =
+            margolusRule(static_cast<std::uint8_t>(state), preferLeft);
+    return table;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Block transitions, toppling right first then left first.
+constexpr std::array<std::array<std::uint8_t, 256>, 2> margolusTables{
+    makeMargolusTable(false), makeMargolusTable(true)
+};
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The table entry of a block that does not change.
+constexpr std::uint8_t margolusIdentity = 0b11100100U;
+
+#endif // MARGOLUS_HPP
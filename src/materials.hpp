@@ -0,0 +1,78 @@
+#pragma once
+#ifndef MATERIALS_HPP
+#define MATERIALS_HPP
+
+#include "components.hpp"
+#include "particle.hpp"
+
+/////////////////////////////////////////////////////////////////////////
+/// \struct MaterialPreset
+/// \brief  The components a particle of a material starts out with.
+struct MaterialPreset {
+    ParticleComponent particle;   ///< The particle, minus its position.
+    FlammableComponent flammable; ///< Attached if the particle is FLAMMABLE.
+    ExplosiveComponent explosive; ///< Attached if the particle is EXPLOSIVE.
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Build the starting components of a material's particles.
+/// \param  material    the material to build.
+/// \return the material's preset.
+inline MaterialPreset makePreset(const Material& material) {
+    MaterialPreset preset;
+    auto& particle = preset.particle;
+    particle.m_material = material;
+    switch (material) {
+    case Material::CONCRETE:
+        particle.m_health = 1000.0F;
+        particle.m_density = 1000.0F;
+        particle.m_color = COLOR_CONCRETE;
+        particle.m_useGravity = false;
+        break;
+    case Material::SAND:
+        particle.m_health = 10.0F;
+        particle.m_density = 1.0F;
+        particle.m_color = COLOR_SAND;
+        break;
+    case Material::OIL:
+        preset.flammable.wickTime = 4.0F;
+        particle.m_health = 4.0F;
+        particle.m_density = 0.6F;
+        particle.m_color = COLOR_OIL;
+        particle.m_state = ParticleComponent::FLAMMABLE;
+        break;
+    case Material::GUNPOWDER:
+        preset.explosive.fuseTime = 0.125F;
+        preset.flammable.wickTime = 1.5F;
+        particle.m_health = 2.5F;
+        particle.m_density = 0.8F;
+        particle.m_color = COLOR_GUNPOWDER;
+        particle.m_state =
+            ParticleComponent::FLAMMABLE | ParticleComponent::EXPLOSIVE;
+        break;
+    case Material::GASOLINE:
+        preset.explosive.fuseTime = 0.875F;
+        preset.flammable.wickTime = 7.5F;
+        particle.m_health = 7.5F;
+        particle.m_density = 0.4F;
+        particle.m_color = COLOR_GASOLINE;
+        particle.m_state =
+            ParticleComponent::FLAMMABLE | ParticleComponent::EXPLOSIVE;
+        break;
+    case Material::WATER:
+        particle.m_health = 10.0F;
+        particle.m_density = 0.7F;
+        particle.m_color = COLOR_WATER;
+        break;
+    case Material::ACID:
+        particle.m_health = 5.0F;
+        particle.m_density = 0.75F;
+        particle.m_color = COLOR_ACID;
+        break;
+    default:
+        break;
+    }
+    return preset;
+}
+
+#endif // MATERIALS_HPP
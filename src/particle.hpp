@@ -4,6 +4,7 @@
 
 #include "Utility/vec.hpp"
 #include <array>
+#include <cstdint>
 
 ///////////////////////////////////////////////////////////////////////////
 /// Use the shared mini namespace
@@ -18,6 +19,27 @@ using namespace mini;
 #define COLOR_GUNPOWDER vec3(0.90F);
 #define COLOR_GASOLINE vec3(0.75F, 0.75F, 0.2F);
 #define COLOR_FIRE vec3(1, 0.2F, 0);
+#define COLOR_WATER vec3(0.15F, 0.35F, 0.8F);
+#define COLOR_ACID vec3(0.45F, 0.9F, 0.1F);
+
+/////////////////////////////////////////////////////////////////////////
+/// \enum   Material
+/// \brief  The substance a particle is made of.
+///         Particles of the same material share their density and gravity.
+enum class Material : std::uint8_t {
+    NONE,
+    CONCRETE,
+    SAND,
+    OIL,
+    GUNPOWDER,
+    GASOLINE,
+    WATER,
+    ACID
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The number of materials, including NONE.
+constexpr size_t materialCount = static_cast<size_t>(Material::ACID) + 1ULL;
 
 /////////////////////////////////////////////////////////////////////////
 /// \class GPU_Particle
@@ -0,0 +1,77 @@
+#include "profiler.hpp"
+#include <cstdlib>
+#include <new>
+
+//////////////////////////////////////////////////////////////////////
+/// Static Members
+//////////////////////////////////////////////////////////////////////
+
+thread_local Profiler::Zone* Profiler::t_zone = nullptr;
+
+//////////////////////////////////////////////////////////////////////
+/// addZone
+//////////////////////////////////////////////////////////////////////
+
+Profiler::Zone& Profiler::addZone(const std::string& name) {
+    auto& zone = m_zones.emplace_back();
+    zone.name = name;
+    return zone;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// beginStep
+//////////////////////////////////////////////////////////////////////
+
+void Profiler::beginStep() noexcept {
+    for (auto& zone : m_zones) {
+        zone.stepAllocations.store(0ULL, std::memory_order_relaxed);
+        zone.stepBytes.store(0ULL, std::memory_order_relaxed);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// getStats
+//////////////////////////////////////////////////////////////////////
+
+std::vector<Profiler::ZoneStats> Profiler::getStats() const {
+    std::vector<ZoneStats> stats;
+    stats.reserve(m_zones.size());
+    for (const auto& zone : m_zones)
+        stats.push_back(ZoneStats{
+            zone.name, zone.stepAllocations.load(std::memory_order_relaxed),
+            zone.stepBytes.load(std::memory_order_relaxed),
+            zone.totalAllocations.load(std::memory_order_relaxed),
+            zone.totalBytes.load(std::memory_order_relaxed) });
+    return stats;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// recordAllocation
+//////////////////////////////////////////////////////////////////////
+
+void Profiler::recordAllocation(const size_t& bytes) noexcept {
+    auto* zone = t_zone;
+    if (zone == nullptr)
+        return;
+    zone->stepAllocations.fetch_add(1ULL, std::memory_order_relaxed);
+    zone->stepBytes.fetch_add(bytes, std::memory_order_relaxed);
+    zone->totalAllocations.fetch_add(1ULL, std::memory_order_relaxed);
+    zone->totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+#ifdef TRACK_ALLOCATIONS
+//////////////////////////////////////////////////////////////////////
+/// Global allocation hook
+//////////////////////////////////////////////////////////////////////
+
+void* operator new(size_t size) {
+    Profiler::recordAllocation(size);
+    if (auto* memory = std::malloc(size == 0ULL ? 1ULL : size))
+        return memory;
+    throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t /*size*/) noexcept {
+    std::free(memory);
+}
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  Profiler
+/// \brief  Attributes heap allocations to named zones, such as systems.
+///         Allocations are only counted when built with TRACK_ALLOCATIONS,
+///         which replaces the global operator new; otherwise every zone
+///         reads zero and entering zones costs a thread-local write.
+class Profiler {
+    public:
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  True if allocations are being counted.
+#ifdef TRACK_ALLOCATIONS
+    static constexpr bool tracksAllocations = true;
+#else
+    static constexpr bool tracksAllocations = false;
+#endif
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \struct Zone
+    /// \brief  Allocation counters of a single zone.
+    struct Zone {
+        std::string name;                          ///< Name of this zone.
+        std::atomic<size_t> stepAllocations{ 0ULL }; ///< Count this step.
+        std::atomic<size_t> stepBytes{ 0ULL };       ///< Bytes this step.
+        std::atomic<size_t> totalAllocations{ 0ULL }; ///< Count overall.
+        std::atomic<size_t> totalBytes{ 0ULL };       ///< Bytes overall.
+    };
+    /////////////////////////////////////////////////////////////////////////
+    /// \struct ZoneStats
+    /// \brief  A snapshot of a zone's counters.
+    struct ZoneStats {
+        std::string name;              ///< Name of the zone.
+        size_t stepAllocations = 0ULL; ///< Allocations made last step.
+        size_t stepBytes = 0ULL;       ///< Bytes allocated last step.
+        size_t totalAllocations = 0ULL; ///< Allocations made overall.
+        size_t totalBytes = 0ULL;       ///< Bytes allocated overall.
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \class  Scope
+    /// \brief  Attributes the current thread's allocations to a zone until
+    ///         destroyed, restoring the previous zone afterwards.
+    class Scope {
+        public:
+        /////////////////////////////////////////////////////////////////////
+        /// \brief  Enter a zone.
+        /// \param  zone    the zone to enter, or nullptr for none.
+        explicit Scope(Zone* zone) noexcept : m_previous(t_zone) {
+            t_zone = zone;
+        }
+        /////////////////////////////////////////////////////////////////////
+        /// \brief  Leave the zone.
+        ~Scope() noexcept { t_zone = m_previous; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        private:
+        Zone* const m_previous; ///< Zone to restore.
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Add a zone.
+    /// \param  name    the name of the zone.
+    /// \return reference to the zone, valid for the profiler's lifetime.
+    Zone& addZone(const std::string& name);
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Reset the per-step counters of every zone.
+    void beginStep() noexcept;
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve a snapshot of every zone's counters.
+    /// \return the stats of each zone, in the order added.
+    [[nodiscard]] std::vector<ZoneStats> getStats() const;
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the zone the calling thread is in.
+    /// \return pointer to the current zone, or nullptr if none.
+    [[nodiscard]] static Zone* currentZone() noexcept { return t_zone; }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Attribute an allocation to the calling thread's zone.
+    /// \param  bytes   the size of the allocation.
+    static void recordAllocation(const size_t& bytes) noexcept;
+
+    private:
+    /////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    std::deque<Zone> m_zones;         ///< Zones in the order added.
+    static thread_local Zone* t_zone; ///< The calling thread's zone.
+};
+
+#endif // PROFILER_HPP
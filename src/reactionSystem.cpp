@@ -0,0 +1,230 @@
+#include "reactionSystem.hpp"
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////
+/// Number of rows each thread scans at a time
+constexpr int bandRows = 64;
+//////////////////////////////////////////////////////////////////////
+/// Number of cells along each side of the particle grid
+constexpr int gridSize = 513;
+static_assert(
+    reactantCount <= 256ULL, "Reactants are noted a byte per grid cell");
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Find a cell's index into the per cell reactants.
+/// \param  x   the cell's column.
+/// \param  y   the cell's row.
+/// \return the cell's index.
+[[nodiscard]] static size_t cellOf(const int& x, const int& y) noexcept {
+    return static_cast<size_t>(y) * gridSize + static_cast<size_t>(x);
+}
+//////////////////////////////////////////////////////////////////////
+/// Health dissolved out of both particles per second of contact
+constexpr float dissolveRate = 40.0F;
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+ReactionSystem::ReactionSystem(
+    ecsWorld& gameWorld,
+    std::shared_ptr<ParticleComponent* [513][513]>& particleArray,
+    const OccupancyGrid& occupancy, StaticLayer& staticLayer,
+    IgnitionSystem& igniter, ThreadPool& threadPool)
+    : m_gameWorld(gameWorld), m_particleArray(particleArray),
+      m_occupancy(occupancy), m_staticLayer(staticLayer), m_igniter(igniter),
+      m_threadPool(threadPool),
+      m_reactants(static_cast<size_t>(gridSize) * gridSize),
+      m_bands(static_cast<size_t>(
+          (playMax - playMin + bandRows) / bandRows)),
+      m_bandDemotions(m_bands.size()) {}
+
+//////////////////////////////////////////////////////////////////////
+/// update
+//////////////////////////////////////////////////////////////////////
+
+void ReactionSystem::update(const double& deltaTime) {
+    // Note reactants band by band, the outer bands also covering the guard
+    // band their neighbours reach into
+    m_threadPool.parallelFor(
+        0ULL, m_bands.size(), 1ULL,
+        [&](const size_t& begin, const size_t& end) {
+            for (size_t band = begin; band < end; ++band) {
+                const int firstY = playMin + static_cast<int>(band) * bandRows;
+                const int lastY = firstY + bandRows - 1;
+                findReactants(
+                    band == 0ULL ? playMin - 1 : firstY,
+                    lastY >= playMax ? guardMax : lastY);
+            }
+        });
+
+    // Scan each band of rows on its own thread, into its own lists
+    m_threadPool.parallelFor(
+        0ULL, m_bands.size(), 1ULL,
+        [&](const size_t& begin, const size_t& end) {
+            for (size_t band = begin; band < end; ++band) {
+                const int firstY = playMin + static_cast<int>(band) * bandRows;
+                findReactions(
+                    firstY, std::min(firstY + bandRows - 1, playMax),
+                    m_bands[band], m_bandDemotions[band]);
+            }
+        });
+
+    // Merge the bands in row order, so results don't depend on threading
+    for (auto& demotions : m_bandDemotions) {
+        m_staticLayer.requestDemotions(demotions);
+        demotions.clear();
+    }
+    for (size_t reaction = 0ULL; reaction < reactionCount; ++reaction) {
+        auto& pairs = m_reactions[reaction];
+        pairs.clear();
+        for (const auto& lists : m_bands)
+            pairs.insert(
+                pairs.end(), lists[reaction].begin(), lists[reaction].end());
+    }
+
+    // Put fires out first, so doused particles don't spread them
+    extinguish();
+    ignite(deltaTime);
+    dissolve(deltaTime);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// findReactants
+//////////////////////////////////////////////////////////////////////
+
+void ReactionSystem::findReactants(const int& firstY, const int& lastY) {
+    // Static cells are noted too, as their neighbours look them up
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int index = 0; index < OccupancyGrid::WORDS; ++index) {
+            const auto bits = m_occupancy.word(y, index);
+            forEachBit(bits, index << 6, [&](const int& x) {
+                m_reactants[cellOf(x, y)] = static_cast<std::uint8_t>(
+                    reactantOf(*m_particleArray[y][x]));
+            });
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// findReactions
+//////////////////////////////////////////////////////////////////////
+
+void ReactionSystem::findReactions(
+    const int& firstY, const int& lastY, ReactionLists& lists,
+    StaticLayer::Demotions& demotions) {
+    for (auto& pairs : lists)
+        pairs.clear();
+    const auto& mask = m_staticLayer.getMask();
+    for (int y = firstY; y <= lastY; ++y) {
+        for (int index = 0; index < OccupancyGrid::WORDS; ++index) {
+            // Static cells only react once returned to the world
+            const auto bits =
+                m_occupancy.word(y, index) & ~mask.word(y, index);
+            forEachBit(bits, index << 6, [&](const int& x) {
+                const auto source = m_reactants[cellOf(x, y)];
+                if (!activeReactants[source])
+                    return;
+
+                // Look up the reaction with each occupied neighbour
+                const auto& reactions = reactionTable[source];
+                auto neighbours = m_occupancy.innerNeighbours(x, y);
+                while (neighbours != 0U) {
+                    const int bit = countTrailingZeros(neighbours);
+                    neighbours &= neighbours - 1U;
+                    const int otherX = x + (bit % 3) - 1;
+                    const int otherY = y + (bit / 3) - 1;
+                    const auto reaction =
+                        reactions[m_reactants[cellOf(otherX, otherY)]];
+                    if (reaction == Reaction::NONE)
+                        continue;
+                    const auto& other = *m_particleArray[otherY][otherX];
+                    if (mask.test(otherX, otherY)) {
+                        // Return promoted particles so they react next step,
+                        // fixed geometry never reacts
+                        if (other.m_useGravity)
+                            demotions.emplace_back(otherX, otherY);
+                        continue;
+                    }
+                    lists[static_cast<size_t>(reaction)].push_back(
+                        { m_particleArray[y][x]->m_entityHandle,
+                          other.m_entityHandle });
+                }
+            });
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// ignite
+//////////////////////////////////////////////////////////////////////
+
+void ReactionSystem::ignite(const double& deltaTime) {
+    const auto burning = [&](const EntityHandle& handle) {
+        const auto entity = m_gameWorld.getEntity(handle);
+        if (!entity)
+            return false;
+        const auto particleComponent = static_cast<ParticleComponent*>(
+            m_gameWorld.getComponent<ParticleComponent>(*entity));
+        return particleComponent != nullptr &&
+               (particleComponent->m_state & ParticleComponent::BURNING) != 0U;
+    };
+    for (const auto& [source, target] : getReactions(Reaction::IGNITE)) {
+        // Fires put out this step no longer spread
+        const auto entity = m_gameWorld.getEntity(target);
+        if (!entity || !burning(source))
+            continue;
+        const auto particleComponent = static_cast<ParticleComponent*>(
+            m_gameWorld.getComponent<ParticleComponent>(*entity));
+        const auto flammableComponent = static_cast<FlammableComponent*>(
+            m_gameWorld.getComponent<FlammableComponent>(*entity));
+        // Skip targets set alight by an earlier pair
+        if (particleComponent == nullptr || flammableComponent == nullptr ||
+            (particleComponent->m_state & (ParticleComponent::FLAMMABLE |
+                                           ParticleComponent::BURNING)) !=
+                ParticleComponent::FLAMMABLE)
+            continue;
+        m_igniter.ignite(
+            *entity, *particleComponent, *flammableComponent, deltaTime);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// extinguish
+//////////////////////////////////////////////////////////////////////
+
+void ReactionSystem::extinguish() {
+    for (const auto& [source, target] : getReactions(Reaction::EXTINGUISH)) {
+        const auto entity = m_gameWorld.getEntity(target);
+        if (!entity)
+            continue;
+        const auto particleComponent = static_cast<ParticleComponent*>(
+            m_gameWorld.getComponent<ParticleComponent>(*entity));
+        if (particleComponent == nullptr ||
+            (particleComponent->m_state & ParticleComponent::BURNING) == 0U)
+            continue;
+
+        // Stays flammable, its pending burn-out and detonation are dropped
+        m_igniter.extinguish(target, *particleComponent);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// dissolve
+//////////////////////////////////////////////////////////////////////
+
+void ReactionSystem::dissolve(const double& deltaTime) {
+    const auto damage = dissolveRate * static_cast<float>(deltaTime);
+    for (const auto& pair : getReactions(Reaction::DISSOLVE)) {
+        // The entity cleanup removes whichever runs out of health
+        for (const auto& handle : { pair.source, pair.target }) {
+            const auto entity = m_gameWorld.getEntity(handle);
+            if (!entity)
+                continue;
+            if (const auto particleComponent =
+                    static_cast<ParticleComponent*>(
+                        m_gameWorld.getComponent<ParticleComponent>(*entity)))
+                particleComponent->m_health -= damage;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+#ifndef REACTIONSYSTEM_HPP
+#define REACTIONSYSTEM_HPP
+
+#include "bitboard.hpp"
+#include "components.hpp"
+#include "ecsWorld.hpp"
+#include "ignitionSystem.hpp"
+#include "reactionTable.hpp"
+#include "staticLayer.hpp"
+#include "threadPool.hpp"
+#include <array>
+#include <memory>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  ReactionSystem
+/// \brief  System used to react touching particles with one another.
+///         A first pass over the grid notes every occupied cell's reactant,
+///         a second looks up every pair of neighbours in the reaction table,
+///         collecting the pairs into a list per reaction, which are then
+///         applied one reaction at a time.
+class ReactionSystem final {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \struct ReactionPair
+    /// \brief  A particle acting on one it touches.
+    struct ReactionPair {
+        EntityHandle source; ///< The particle acting.
+        EntityHandle target; ///< The particle acted on.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a reaction system.
+    /// \param  gameWorld       reference to the engine's game world.
+    /// \param  particleArray   structure identifying particles spatially.
+    /// \param  occupancy       bits marking the occupied particle cells.
+    /// \param  staticLayer     particles kept out of the world, which don't
+    ///                         react until returned to it.
+    /// \param  igniter         the system setting particles on fire.
+    /// \param  threadPool      the threads to scan bands of rows on.
+    ReactionSystem(
+        ecsWorld& gameWorld,
+        std::shared_ptr<ParticleComponent* [513][513]>& particleArray,
+        const OccupancyGrid& occupancy, StaticLayer& staticLayer,
+        IgnitionSystem& igniter, ThreadPool& threadPool);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Tick this system ahead by a single step. The grid must
+    ///         have been rebuilt since particles were last added.
+    /// \param  deltaTime   the duration of a step.
+    void update(const double& deltaTime);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the pairs found reacting by the last step.
+    /// \param  reaction    the reaction to retrieve.
+    /// \return reference to the reaction's pairs, in grid order.
+    [[nodiscard]] const std::vector<ReactionPair>&
+    getReactions(const Reaction& reaction) const noexcept {
+        return m_reactions[static_cast<size_t>(reaction)];
+    }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  A list of pairs per reaction.
+    using ReactionLists = std::array<std::vector<ReactionPair>, reactionCount>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Note the reactant of every occupied cell of a band of rows.
+    /// \param  firstY      the band's first row.
+    /// \param  lastY       the band's last row.
+    void findReactants(const int& firstY, const int& lastY);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Collect the reacting pairs of a band of rows, whose reactants
+    ///         and their neighbours' have been noted.
+    /// \param  firstY      the band's first row.
+    /// \param  lastY       the band's last row.
+    /// \param  lists       the band's lists to fill.
+    /// \param  demotions   the band's static cells to return to the world.
+    void findReactions(
+        const int& firstY, const int& lastY, ReactionLists& lists,
+        StaticLayer::Demotions& demotions);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Set the targets of IGNITE pairs on fire.
+    /// \param  deltaTime   the duration of a step.
+    void ignite(const double& deltaTime);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Put out the targets of EXTINGUISH pairs.
+    void extinguish();
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Damage both particles of DISSOLVE pairs.
+    /// \param  deltaTime   the duration of a step.
+    void dissolve(const double& deltaTime);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    ecsWorld& m_gameWorld;
+    std::shared_ptr<ParticleComponent* [513][513]>& m_particleArray;
+    const OccupancyGrid& m_occupancy;
+    StaticLayer& m_staticLayer;
+    IgnitionSystem& m_igniter;
+    ThreadPool& m_threadPool;
+    std::vector<std::uint8_t> m_reactants; ///< Occupied cells' reactants.
+    std::vector<ReactionLists> m_bands;    ///< Each band of rows' pairs.
+    std::vector<StaticLayer::Demotions>
+        m_bandDemotions;       ///< Each band of rows' cells to demote.
+    ReactionLists m_reactions; ///< Every band's pairs, in order.
+};
+
+#endif // REACTIONSYSTEM_HPP
@@ -0,0 +1,85 @@
+#pragma once
+#ifndef REACTIONTABLE_HPP
+#define REACTIONTABLE_HPP
+
+#include "components.hpp"
+#include "particle.hpp"
+#include <array>
+#include <cstdint>
+
+/////////////////////////////////////////////////////////////////////////
+/// \enum   Reaction
+/// \brief  What happens when a particle touches another.
+enum class Reaction : std::uint8_t {
+    NONE,       ///< Nothing happens.
+    IGNITE,     ///< The other particle catches fire.
+    EXTINGUISH, ///< The other particle's fire goes out.
+    DISSOLVE,   ///< Both particles eat away at each other.
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The number of reactions, including NONE.
+constexpr size_t reactionCount =
+    static_cast<size_t>(Reaction::DISSOLVE) + 1ULL;
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The reactant of burning particles, whatever their material.
+constexpr size_t fireReactant = materialCount;
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The number of reactants, every material plus fire.
+constexpr size_t reactantCount = materialCount + 1ULL;
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Find what a particle reacts as.
+/// \param  particle    the particle to classify.
+/// \return fireReactant if it is burning, otherwise its material.
+[[nodiscard]] inline size_t
+reactantOf(const ParticleComponent& particle) noexcept {
+    return (particle.m_state & ParticleComponent::BURNING) != 0U
+               ? fireReactant
+               : static_cast<size_t>(particle.m_material);
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Reactions indexed by the reactant acting, then the one touched.
+using ReactionTable =
+    std::array<std::array<Reaction, reactantCount>, reactantCount>;
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Build the table of every material pair's reaction.
+/// \return the reaction table.
+constexpr ReactionTable makeReactionTable() noexcept {
+    constexpr auto material = [](const Material& value) {
+        return static_cast<size_t>(value);
+    };
+    ReactionTable table{};
+    table[fireReactant][material(Material::OIL)] = Reaction::IGNITE;
+    table[fireReactant][material(Material::GUNPOWDER)] = Reaction::IGNITE;
+    table[fireReactant][material(Material::GASOLINE)] = Reaction::IGNITE;
+    table[material(Material::WATER)][fireReactant] = Reaction::EXTINGUISH;
+    table[material(Material::ACID)][material(Material::SAND)] =
+        Reaction::DISSOLVE;
+    return table;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  The reaction of every pair of touching reactants.
+constexpr ReactionTable reactionTable = makeReactionTable();
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Find which reactants act on anything at all, so the rest can
+///         skip looking at their neighbours.
+/// \return true for each reactant with a reaction.
+constexpr std::array<bool, reactantCount> findActiveReactants() noexcept {
+    std::array<bool, reactantCount> active{};
+    for (size_t source = 0ULL; source < reactantCount; ++source)
+        for (const auto& reaction : reactionTable[source])
+            active[source] = active[source] || reaction != Reaction::NONE;
+    return active;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  True for each reactant with a reaction.
+constexpr std::array<bool, reactantCount> activeReactants =
+    findActiveReactants();
+
+#endif // REACTIONTABLE_HPP
@@ -38,10 +38,10 @@ constexpr auto const fragCode = R"END(
 /// Custom Constructor
 //////////////////////////////////////////////////////////////////////
 
-RenderSystem::RenderSystem()
+RenderSystem::RenderSystem(StaticLayer& staticLayer)
     : m_shader(vertCode, fragCode), m_model({ vec3(-1, -1, 0), vec3(1, -1, 0),
                                               vec3(1, 1, 0), vec3(-1, 1, 0) }),
-      m_draw(4, 0, 0, GL_DYNAMIC_STORAGE_BIT) {
+      m_draw(4, 0, 0, GL_DYNAMIC_STORAGE_BIT), m_staticLayer(staticLayer) {
     addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
     addComponentType(OnFireComponent::Runtime_ID, RequirementsFlag::OPTIONAL);
 
@@ -61,23 +61,20 @@ RenderSystem::RenderSystem()
 void RenderSystem::updateComponents(
     const double& /*deltaTime*/,
     const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
+    packParticles(entityComponents, m_staticLayer.getPacked(), m_particles);
+    render(m_particles);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// render
+//////////////////////////////////////////////////////////////////////
+
+void RenderSystem::render(const std::vector<GPU_Particle>& particles) {
     // Update buffered data
-    m_draw.setPrimitiveCount(static_cast<GLuint>(entityComponents.size()));
+    m_draw.setPrimitiveCount(static_cast<GLuint>(particles.size()));
     m_dataBuffer.beginWriting();
-    size_t offset(0ULL);
-    for (const auto& components : entityComponents) {
-        // Convert game particles into GPU renderable particles
-        const auto& particle =
-            *static_cast<ParticleComponent*>(components.front());
-        const GPU_Particle data{
-            particle.m_color, components.back() != nullptr ? 1 : 0,
-            vec2(
-                static_cast<float>(static_cast<int>(particle.m_pos.x())),
-                static_cast<float>(static_cast<int>(particle.m_pos.y())))
-        };
-        m_dataBuffer.write(offset, sizeof(GPU_Particle), &data);
-        offset += sizeof(GPU_Particle);
-    }
+    m_dataBuffer.write(
+        0ULL, sizeof(GPU_Particle) * particles.size(), particles.data());
     m_dataBuffer.endWriting();
 
     // Flush buffers and set starting parameters
@@ -90,4 +87,38 @@ void RenderSystem::updateComponents(
     m_dataBuffer.bindBufferBase(GL_SHADER_STORAGE_BUFFER, 1);
     m_draw.drawCall(GL_QUADS);
     m_dataBuffer.endReading();
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////
+/// packParticles
+//////////////////////////////////////////////////////////////////////
+
+void RenderSystem::packParticles(
+    const std::vector<std::vector<ecsBaseComponent*>>& entityComponents,
+    std::vector<GPU_Particle>& particles) {
+    particles.clear();
+    particles.reserve(entityComponents.size());
+    for (const auto [particle, onFire] :
+         ComponentView<ParticleComponent, OnFireComponent*>(entityComponents)) {
+        // Convert game particles into GPU renderable particles
+        const bool burning =
+            onFire != nullptr ||
+            (particle.m_state & ParticleComponent::BURNING) != 0U;
+        particles.push_back(GPU_Particle{
+            particle.m_color, burning ? 1 : 0,
+            vec2(
+                static_cast<float>(static_cast<int>(particle.m_pos.x())),
+                static_cast<float>(static_cast<int>(particle.m_pos.y()))) });
+    }
+}
+
+void RenderSystem::packParticles(
+    const std::vector<std::vector<ecsBaseComponent*>>& entityComponents,
+    const std::vector<GPU_Particle>& geometry,
+    std::vector<GPU_Particle>& particles) {
+    // Reserve for both up front, so appending the geometry never reallocates
+    particles.clear();
+    particles.reserve(entityComponents.size() + geometry.size());
+    packParticles(entityComponents, particles);
+    particles.insert(particles.end(), geometry.cbegin(), geometry.cend());
+}
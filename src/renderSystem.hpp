@@ -6,8 +6,12 @@
 #include "Multibuffer/glDynamicMultiBuffer.hpp"
 #include "Utility/indirectDraw.hpp"
 #include "Utility/shader.hpp"
+#include "componentView.hpp"
 #include "components.hpp"
 #include "ecsSystem.hpp"
+#include "particle.hpp"
+#include "staticLayer.hpp"
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////
 /// Use the shared mini namespace
@@ -20,7 +24,8 @@ class RenderSystem final : public ecsSystem {
     public:
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Construct a rendering system.
-    RenderSystem();
+    /// \param  staticLayer the static geometry drawn along the particles.
+    explicit RenderSystem(StaticLayer& staticLayer);
 
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Tick this system by deltaTime.
@@ -30,12 +35,35 @@ class RenderSystem final : public ecsSystem {
         const double& deltaTime,
         const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
         final;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Render a previously packed set of particles.
+    /// \param  particles       the GPU renderable particles to draw.
+    void render(const std::vector<GPU_Particle>& particles);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Convert game particles into GPU renderable particles.
+    /// \param  entityComponents    particle and optional on-fire components.
+    /// \param  particles           the container to overwrite.
+    static void packParticles(
+        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents,
+        std::vector<GPU_Particle>& particles);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Convert game particles into GPU renderable particles,
+    ///         followed by already packed static geometry.
+    /// \param  entityComponents    particle and optional on-fire components.
+    /// \param  geometry            the packed static geometry to append.
+    /// \param  particles           the container to overwrite.
+    static void packParticles(
+        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents,
+        const std::vector<GPU_Particle>& geometry,
+        std::vector<GPU_Particle>& particles);
 
     private:
     Shader m_shader;                      ///< A shader for displaying particles
     Model m_model;                        ///< A model for particles
     IndirectDraw m_draw;                  ///< An indirect draw call GL object
     glDynamicMultiBuffer<3> m_dataBuffer; ///< GPU data container
+    std::vector<GPU_Particle> m_particles; ///< CPU side particle data
+    StaticLayer& m_staticLayer;            ///< Static geometry to draw
 };
 
 #endif // RENDERSYSTEM_HPP
\ No newline at end of file
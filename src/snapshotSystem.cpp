@@ -0,0 +1,27 @@
+#include "snapshotSystem.hpp"
+#include "renderSystem.hpp"
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+SnapshotSystem::SnapshotSystem(
+    TripleBuffer<std::vector<GPU_Particle>>& snapshots,
+    StaticLayer& staticLayer)
+    : m_snapshots(snapshots), m_staticLayer(staticLayer) {
+    addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
+    addComponentType(OnFireComponent::Runtime_ID, RequirementsFlag::OPTIONAL);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// updateComponents
+//////////////////////////////////////////////////////////////////////
+
+void SnapshotSystem::updateComponents(
+    const double& /*deltaTime*/,
+    const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
+    RenderSystem::packParticles(
+        entityComponents, m_staticLayer.getPacked(),
+        m_snapshots.getWriteBuffer());
+    m_snapshots.publish();
+}
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef SNAPSHOTSYSTEM_HPP
+#define SNAPSHOTSYSTEM_HPP
+
+#include "components.hpp"
+#include "ecsSystem.hpp"
+#include "particle.hpp"
+#include "staticLayer.hpp"
+#include "tripleBuffer.hpp"
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  SnapshotSystem
+/// \brief  System used to publish an immutable render snapshot of the world.
+class SnapshotSystem final : public ecsSystem {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a snapshot system.
+    /// \param  snapshots   the buffers to publish snapshots into.
+    /// \param  staticLayer the static geometry published along the particles.
+    SnapshotSystem(
+        TripleBuffer<std::vector<GPU_Particle>>& snapshots,
+        StaticLayer& staticLayer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Tick this system by deltaTime.
+    /// \param	deltaTime	    the amount of time passed since last update.
+    /// \param	components	    the components to update.
+    void updateComponents(
+        const double&,
+        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
+        final;
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    TripleBuffer<std::vector<GPU_Particle>>& m_snapshots;
+    StaticLayer& m_staticLayer;
+};
+
+#endif // SNAPSHOTSYSTEM_HPP
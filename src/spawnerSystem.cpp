@@ -1,16 +1,29 @@
 #include "spawnerSystem.hpp"
 #include "collision.hpp"
+#include "materials.hpp"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+//////////////////////////////////////////////////////////////////////
+/// Cursor value marking a finished brush
+constexpr auto finishedBrush = std::numeric_limits<size_t>::max();
 
 //////////////////////////////////////////////////////////////////////
 /// Custom Constructor
 //////////////////////////////////////////////////////////////////////
 
 SpawnerSystem::SpawnerSystem(
-    ecsWorld& gameWorld,
-    std::shared_ptr<ParticleComponent* [513][513]>& particleArray)
-    : m_gameWorld(gameWorld), m_particleArray(particleArray) {
+    ecsWorld& gameWorld, OccupancyGrid& occupancy, const CounterRNG& rng,
+    EntityPool& entityPool)
+    : m_gameWorld(gameWorld), m_occupancy(occupancy), m_rng(rng),
+      m_entityPool(entityPool) {
     addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
     addComponentType(SpawnerComponent::Runtime_ID, RequirementsFlag::REQUIRED);
+    // Faucets pour the same sand as the world builder, as settling cells a
+    // word at a time relies on a material's particles sharing a density
+    m_faucetParticle = makePreset(Material::SAND).particle;
+    m_spawnCells.reserve(m_spawnBudget);
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -20,36 +33,114 @@ SpawnerSystem::SpawnerSystem(
 void SpawnerSystem::updateComponents(
     const double& /*deltaTime*/,
     const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
-    constexpr std::array<float, 16> noise = {
-        0.0774344872F, 0.0880199587F, 0.5709270134F, 0.2659348386F,
-        0.6522730960F, 0.9039410920F, 0.0648135795F, 0.9500589706F,
-        0.3770664946F, 0.2918298451F, 0.8389844759F, 0.1398756207F,
-        0.7765582152F, 0.9703763453F, 0.2976069829F, 0.7423728685F
-    };
-    static int index = 0;
-
-    for (const auto& components : entityComponents) {
-        const auto& particleComponent =
-            *static_cast<ParticleComponent*>(components[0]);
+    m_spawnCells.clear();
+
+    // Claim a cell beneath each faucet
+    for (const auto [particleComponent, spawnerComponent] :
+         ComponentView<ParticleComponent, SpawnerComponent>(
+             entityComponents)) {
         const int x = static_cast<int>(particleComponent.m_pos.x());
         const int y = static_cast<int>(particleComponent.m_pos.y());
+#ifdef DEBUG
+        // Faucets must sit inside the guard band, so their walls bound them
+        assert(inPlayArea(x, y));
+#endif
 
-        const int newX = (x - 1) + static_cast<int>(noise[index] * 3.0F);
-        index = ++index % 16;
-        const int newY = (y - 1) + static_cast<int>(noise[index] * 2.0F);
-        index = ++index % 16;
-        if (newX > 0 && newX < 511 && newY > 0 && newY < 511) {
-            if (m_particleArray[newY][newX] == nullptr) {
-                ParticleComponent particle;
-                particle.m_health = 10.0F;
-                particle.m_density = 0.0F;
-                particle.m_useGravity = true;
-                particle.m_pos =
-                    vec2(static_cast<float>(newX), static_cast<float>(newY));
-                particle.m_color = COLOR_SAND;
-                auto entityHandle = m_gameWorld.makeEntity();
-                m_gameWorld.makeComponent(entityHandle, &particle);
-            }
+        const int newX =
+            (x - 1) + static_cast<int>(m_rng.uniform(x, y, 0U) * 3.0F);
+        const int newY =
+            (y - 1) + static_cast<int>(m_rng.uniform(x, y, 1U) * 2.0F);
+        // The guard band is occupied, so this also keeps the cell in bounds.
+        // Only the occupancy bit is claimed, the particle grid is left to
+        // the next rebuild, as the prototypes aren't part of the world
+        if (!m_occupancy.test(newX, newY) &&
+            m_spawnCells.size() < m_spawnBudget) {
+            m_occupancy.set(newX, newY);
+            m_spawnCells.emplace_back(
+                &m_faucetParticle,
+                vec2(static_cast<float>(newX), static_cast<float>(newY)));
         }
     }
-}
\ No newline at end of file
+
+    // Claim cells for each brush, resuming where the last step left off
+    for (auto& [brush, cursor] : m_brushes) {
+        if (!claimCells(brush, cursor))
+            break;
+        cursor = brush.continuous ? 0ULL : finishedBrush;
+    }
+
+    // Create every claimed particle in a single pass, recycling dead ones
+    for (const auto& [prototype, position] : m_spawnCells) {
+        ParticleComponent particle = *prototype;
+        particle.m_pos = position;
+        m_entityPool.spawn(particle);
+    }
+    m_brushes.erase(
+        std::remove_if(
+            m_brushes.begin(), m_brushes.end(),
+            [](const auto& brush) { return brush.second == finishedBrush; }),
+        m_brushes.end());
+}
+
+//////////////////////////////////////////////////////////////////////
+/// queueBrush
+//////////////////////////////////////////////////////////////////////
+
+void SpawnerSystem::queueBrush(const SpawnBrush& brush) {
+    m_brushes.emplace_back(brush, 0ULL);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// clearBrushes
+//////////////////////////////////////////////////////////////////////
+
+void SpawnerSystem::clearBrushes() noexcept { m_brushes.clear(); }
+
+//////////////////////////////////////////////////////////////////////
+/// setSpawnBudget
+//////////////////////////////////////////////////////////////////////
+
+void SpawnerSystem::setSpawnBudget(const size_t& budget) {
+    m_spawnBudget = budget;
+    m_spawnCells.reserve(m_spawnBudget);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// claimCells
+//////////////////////////////////////////////////////////////////////
+
+bool SpawnerSystem::claimCells(SpawnBrush& brush, size_t& cursor) {
+    // Clamp the brush to the playable area once, rather than per cell
+    const int centerX = static_cast<int>(brush.center.x());
+    const int centerY = static_cast<int>(brush.center.y());
+    const int minX = std::max(centerX - brush.radius, playMin);
+    const int maxX = std::min(centerX + brush.radius, playMax);
+    const int minY = std::max(centerY - brush.radius, playMin);
+    const int maxY = std::min(centerY + brush.radius, playMax);
+    if (minX > maxX || minY > maxY)
+        return true;
+
+    const auto width = static_cast<size_t>(maxX - minX + 1);
+    const auto cellCount = width * static_cast<size_t>(maxY - minY + 1);
+    const int radiusSquared = brush.radius * brush.radius;
+    for (; cursor < cellCount; ++cursor) {
+        if (m_spawnCells.size() >= m_spawnBudget)
+            return false;
+
+        const int x = minX + static_cast<int>(cursor % width);
+        const int y = minY + static_cast<int>(cursor / width);
+        const int dx = x - centerX;
+        const int dy = y - centerY;
+        if (dx * dx + dy * dy > radiusSquared ||
+            m_occupancy.test(x, y) ||
+            m_rng.uniform(x, y, 2U) >= brush.fillRatio)
+            continue;
+
+        // Mark the cell as taken for the remainder of this step
+        m_occupancy.set(x, y);
+        m_spawnCells.emplace_back(
+            &brush.particle,
+            vec2(static_cast<float>(x), static_cast<float>(y)));
+    }
+    return true;
+}
@@ -2,25 +2,48 @@
 #ifndef SPAWNERSYSTEM_HPP
 #define SPAWNERSYSTEM_HPP
 
+#include "bitboard.hpp"
+#include "componentView.hpp"
 #include "components.hpp"
+#include "counterRNG.hpp"
 #include "ecsSystem.hpp"
 #include "ecsWorld.hpp"
+#include "entityPool.hpp"
+#include "guardBand.hpp"
+#include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////
 /// Use the shared mini namespace
 using namespace mini;
 
+/////////////////////////////////////////////////////////////////////////
+/// \struct SpawnBrush
+/// \brief  A circular area to fill with copies of a particle.
+struct SpawnBrush {
+    ParticleComponent particle; ///< The particle to stamp into each cell.
+    vec2 center = vec2(0.0F);   ///< The center of the brush.
+    int radius = 1;             ///< The radius of the brush, in cells.
+    float fillRatio = 1.0F;     ///< The fraction of empty cells to fill.
+    bool continuous = false;    ///< Re-apply every step, as an area emitter.
+};
+
 /////////////////////////////////////////////////////////////////////////
 /// \class  SpawnerSystem
-/// \brief  System used to spawn new particles out faucets.
+/// \brief  System used to spawn new particles out faucets and brushes.
+///         Spawning is limited to a budget of particles per step, large
+///         brushes resume where they left off on the following steps.
 class SpawnerSystem final : public ecsSystem {
     public:
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Construct a spawner system.
     /// \param  gameWorld       reference to the engine's game world.
-    /// \param  particleArray   structure identifying particles spatially.
-    SpawnerSystem(ecsWorld& gameWorld,
-        std::shared_ptr<ParticleComponent* [513][513]>& particleArray);
+    /// \param  occupancy       bits marking the occupied particle cells.
+    /// \param  rng             the simulation's random number generator.
+    /// \param  entityPool      pool of dead entities to spawn into.
+    SpawnerSystem(
+        ecsWorld& gameWorld, OccupancyGrid& occupancy, const CounterRNG& rng,
+        EntityPool& entityPool);
 
     ///////////////////////////////////////////////////////////////////////////
     /// \brief  Tick this system by deltaTime.
@@ -31,11 +54,44 @@ class SpawnerSystem final : public ecsSystem {
         const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
         final;
 
-private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Queue a brush, spawning its particles over the next steps.
+    /// \param  brush   the brush to apply.
+    void queueBrush(const SpawnBrush& brush);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Remove all queued brushes and area emitters.
+    void clearBrushes() noexcept;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Set the most particles this system may spawn per step.
+    /// \param  budget  the particle budget per step.
+    void setSpawnBudget(const size_t& budget);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of particles spawned last step.
+    /// \return the number of particles spawned last step.
+    [[nodiscard]] size_t getSpawnCount() const noexcept {
+        return m_spawnCells.size();
+    }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Claim empty cells of a brush, resuming from its cursor.
+    /// \param  brush   the brush to apply.
+    /// \param  cursor  the bounds-relative index of the next cell to visit.
+    /// \return true if the brush visited all of its cells.
+    bool claimCells(SpawnBrush& brush, size_t& cursor);
+
     ///////////////////////////////////////////////////////////////////////////
     /// Private Members
     ecsWorld& m_gameWorld;
-    std::shared_ptr<ParticleComponent* [513][513]>& m_particleArray;
+    OccupancyGrid& m_occupancy;
+    const CounterRNG& m_rng;
+    EntityPool& m_entityPool;
+    size_t m_spawnBudget = 4096ULL;   ///< Most particles to spawn per step.
+    ParticleComponent m_faucetParticle; ///< The particle faucets spawn.
+    std::vector<std::pair<SpawnBrush, size_t>>
+        m_brushes; ///< Queued brushes and their cursors.
+    std::vector<std::pair<const ParticleComponent*, vec2>>
+        m_spawnCells; ///< Particles to spawn this step, and where.
 };
 
 #endif // SPAWNERSYSTEM_HPP
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "staticGeometrySystem.hpp"
+#include <limits>
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+StaticGeometrySystem::StaticGeometrySystem(
+    ecsWorld& gameWorld, StaticLayer& staticLayer, EntityPool& entityPool,
+    FrameArena& frameArena)
+    : m_gameWorld(gameWorld), m_staticLayer(staticLayer),
+      m_entityPool(entityPool), m_frameArena(frameArena) {
+    addComponentType(ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// updateComponents
+//////////////////////////////////////////////////////////////////////
+
+void StaticGeometrySystem::updateComponents(
+    const double& /*deltaTime*/,
+    const std::vector<std::vector<ecsBaseComponent*>>& entityComponents) {
+    // The grid was rebuilt since the last update, removed cells are gone
+    m_staticLayer.reclaimSlots();
+
+    // Return disturbed cells first, so nothing is promoted onto them
+    auto& demotions = m_staticLayer.getDemotions();
+    for (const auto& [x, y] : demotions)
+        demote(x, y);
+    demotions.clear();
+    if (m_promotionSteps == 0U)
+        return;
+
+    // Find plain particles that rested long enough on static cells
+    ArenaVector<EntityHandle> promotions{ ArenaAllocator<EntityHandle>(
+        m_frameArena) };
+    for (const auto [particleComponent] :
+         ComponentView<ParticleComponent>(entityComponents)) {
+        if (!particleComponent.m_asleep || !particleComponent.m_useGravity ||
+            particleComponent.m_state != 0U) {
+            particleComponent.m_restSteps = 0U;
+            continue;
+        }
+        if (particleComponent.m_restSteps <
+            std::numeric_limits<std::uint8_t>::max())
+            ++particleComponent.m_restSteps;
+
+        const int x = static_cast<int>(particleComponent.m_pos.x());
+        const int y = static_cast<int>(particleComponent.m_pos.y());
+        if (particleComponent.m_restSteps >= m_promotionSteps &&
+            m_staticLayer.test(x - 1, y - 1) && m_staticLayer.test(x, y - 1) &&
+            m_staticLayer.test(x + 1, y - 1))
+            promotions.emplace_back(particleComponent.m_entityHandle);
+    }
+
+    // Copy each into the layer before releasing its entity
+    for (const auto& handle : promotions) {
+        const auto entity = m_gameWorld.getEntity(handle);
+        if (!entity)
+            continue;
+        const auto particleComponent = static_cast<ParticleComponent*>(
+            m_gameWorld.getComponent<ParticleComponent>(*entity));
+        if (particleComponent == nullptr)
+            continue;
+        m_staticLayer.add(*particleComponent);
+        m_entityPool.release(handle);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// demote
+//////////////////////////////////////////////////////////////////////
+
+void StaticGeometrySystem::demote(const int& x, const int& y) {
+    ArenaVector<std::pair<int, int>> cells{
+        ArenaAllocator<std::pair<int, int>>(m_frameArena)
+    };
+    cells.emplace_back(x, y);
+    while (!cells.empty()) {
+        const auto [cellX, cellY] = cells.back();
+        cells.pop_back();
+        // Only promoted particles move again, fixed geometry stays put, so
+        // the walk ends at the guard band at the latest
+        if (!m_staticLayer.test(cellX, cellY) ||
+            !m_staticLayer.get(cellX, cellY).m_useGravity)
+            continue;
+
+        auto particle = m_staticLayer.remove(cellX, cellY);
+        particle.m_asleep = false;
+        particle.m_restSteps = 0U;
+        m_entityPool.spawn(particle);
+
+        // Whatever rested on this cell lost its support
+        for (int dx = -1; dx <= 1; ++dx)
+            cells.emplace_back(cellX + dx, cellY + 1);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#ifndef STATICGEOMETRYSYSTEM_HPP
+#define STATICGEOMETRYSYSTEM_HPP
+
+#include "componentView.hpp"
+#include "components.hpp"
+#include "ecsSystem.hpp"
+#include "ecsWorld.hpp"
+#include "entityPool.hpp"
+#include "frameArena.hpp"
+#include "staticLayer.hpp"
+
+///////////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  StaticGeometrySystem
+/// \brief  System moving particles between the world and the static layer.
+///         Plain particles resting on static cells for long enough are
+///         promoted into the layer, and static cells something tried to
+///         displace are demoted back, along with anything resting on them.
+class StaticGeometrySystem final : public ecsSystem {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a static geometry system.
+    /// \param  gameWorld   reference to the engine's game world.
+    /// \param  staticLayer the layer to promote particles into.
+    /// \param  entityPool  pool recycling the entities of moved particles.
+    /// \param  frameArena  arena holding this step's scratch data.
+    StaticGeometrySystem(
+        ecsWorld& gameWorld, StaticLayer& staticLayer, EntityPool& entityPool,
+        FrameArena& frameArena);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Tick this system by deltaTime.
+    /// \param	deltaTime	    the amount of time passed since last update.
+    /// \param	components	    the components to update.
+    void updateComponents(
+        const double&,
+        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
+        final;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Set how long a particle must rest before being promoted.
+    /// \param  steps   the number of steps asleep, 0 disables promotion.
+    void setPromotionSteps(const std::uint8_t& steps) noexcept {
+        m_promotionSteps = steps;
+    }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Return a static cell to the world, and everything resting on
+    ///         it in turn. Fixed geometry without gravity is never demoted.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    void demote(const int& x, const int& y);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    ecsWorld& m_gameWorld;
+    StaticLayer& m_staticLayer;
+    EntityPool& m_entityPool;
+    FrameArena& m_frameArena;
+    std::uint8_t m_promotionSteps = 64U; ///< Steps asleep before promotion.
+};
+
+#endif // STATICGEOMETRYSYSTEM_HPP
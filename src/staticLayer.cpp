@@ -0,0 +1,131 @@
+#include "staticLayer.hpp"
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+StaticLayer::StaticLayer(
+    std::shared_ptr<ParticleComponent* [513][513]>& particleArray,
+    OccupancyGrid& occupancy)
+    : m_particleArray(particleArray), m_occupancy(occupancy) {}
+
+//////////////////////////////////////////////////////////////////////
+/// add
+//////////////////////////////////////////////////////////////////////
+
+void StaticLayer::add(const ParticleComponent& particle) {
+    const int x = static_cast<int>(particle.m_pos.x());
+    const int y = static_cast<int>(particle.m_pos.y());
+    if (m_mask.test(x, y))
+        return;
+
+    // Keep particles at stable addresses, the grid points straight at them
+    ParticleComponent* slot = nullptr;
+    if (m_freeSlots.empty())
+        slot = &m_particles.emplace_back(particle);
+    else {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        *slot = particle;
+    }
+    slot->m_velocity = vec2(0.0F);
+    slot->m_asleep = true;
+
+    m_particleArray[y][x] = slot;
+    m_occupancy.set(x, y);
+    m_mask.set(x, y);
+    ++m_count;
+    m_dirty = true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// addGuardBand
+//////////////////////////////////////////////////////////////////////
+
+void StaticLayer::addGuardBand(const ParticleComponent& wall) {
+    ParticleComponent particle = wall;
+    for (int index = 0; index <= guardMax; ++index) {
+        const auto offset = static_cast<float>(index);
+        particle.m_pos = vec2(offset, 0.0F);
+        add(particle);
+        particle.m_pos = vec2(offset, static_cast<float>(guardMax));
+        add(particle);
+        particle.m_pos = vec2(0.0F, offset);
+        add(particle);
+        particle.m_pos = vec2(static_cast<float>(guardMax), offset);
+        add(particle);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// remove
+//////////////////////////////////////////////////////////////////////
+
+ParticleComponent StaticLayer::remove(const int& x, const int& y) {
+    auto* slot = m_particleArray[y][x];
+    m_removedSlots.emplace_back(slot);
+    m_mask.reset(x, y);
+    --m_count;
+    m_dirty = true;
+    return *slot;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// reclaimSlots
+//////////////////////////////////////////////////////////////////////
+
+void StaticLayer::reclaimSlots() {
+    m_freeSlots.insert(
+        m_freeSlots.end(), m_removedSlots.cbegin(), m_removedSlots.cend());
+    m_removedSlots.clear();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// requestDemotions
+//////////////////////////////////////////////////////////////////////
+
+void StaticLayer::requestDemotions(const Demotions& cells) {
+    m_demotions.insert(m_demotions.end(), cells.cbegin(), cells.cend());
+}
+
+//////////////////////////////////////////////////////////////////////
+/// getPacked
+//////////////////////////////////////////////////////////////////////
+
+const std::vector<GPU_Particle>& StaticLayer::getPacked() {
+    if (!m_dirty)
+        return m_packed;
+
+    m_packed.clear();
+    m_packed.reserve(m_count);
+    for (int y = 0; y < 513; ++y)
+        m_mask.forEach(y, [&](const int& x) {
+            const auto& particle = *m_particleArray[y][x];
+            m_packed.push_back(GPU_Particle{
+                particle.m_color, 0,
+                vec2(static_cast<float>(x), static_cast<float>(y)) });
+        });
+    m_dirty = false;
+    return m_packed;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// guardBandIntact
+//////////////////////////////////////////////////////////////////////
+
+bool StaticLayer::guardBandIntact() const noexcept {
+    const auto isWall = [&](const int& x, const int& y) {
+        return m_mask.test(x, y) && m_occupancy.test(x, y) &&
+               !m_particleArray[y][x]->m_useGravity;
+    };
+    for (int index = 0; index <= guardMax; ++index)
+        if (!isWall(index, 0) || !isWall(index, guardMax) ||
+            !isWall(0, index) || !isWall(guardMax, index))
+            return false;
+
+    // Nothing may have slipped past the ring into the padding
+    for (int index = 0; index < 513; ++index)
+        if (m_occupancy.test(512, index) || m_occupancy.test(index, 512))
+            return false;
+    return true;
+}
@@ -0,0 +1,126 @@
+#pragma once
+#ifndef STATICLAYER_HPP
+#define STATICLAYER_HPP
+
+#include "bitboard.hpp"
+#include "components.hpp"
+#include "guardBand.hpp"
+#include "particle.hpp"
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  StaticLayer
+/// \brief  Particles that don't move, kept out of the ECS and written into
+///         the grid once. Cells in the layer's mask are never cleared or
+///         moved by the collision system, and are drawn from a cached
+///         buffer only re-packed when the layer changes. Holds fixed
+///         geometry, and resting particles promoted out of the world until
+///         something disturbs them.
+class StaticLayer {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Cells asked to be returned to the world.
+    using Demotions = std::vector<std::pair<int, int>>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct an empty layer over the simulation's grids.
+    /// \param  particleArray   structure identifying particles spatially.
+    /// \param  occupancy       bits marking the occupied particle cells.
+    StaticLayer(
+        std::shared_ptr<ParticleComponent* [513][513]>& particleArray,
+        OccupancyGrid& occupancy);
+    StaticLayer(const StaticLayer&) = delete;
+    StaticLayer& operator=(const StaticLayer&) = delete;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Write a particle into the grid at its position, for good.
+    ///         Does nothing if the cell is already static.
+    /// \param  particle    the particle to copy into the layer.
+    void add(const ParticleComponent& particle);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Write the guard band's ring of walls around the play area.
+    /// \param  wall    the particle to copy into each ring cell, which must
+    ///                 have no gravity.
+    void addGuardBand(const ParticleComponent& wall);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Take a particle back out of the layer.
+    ///         The cell stays occupied until the collision system next
+    ///         rebuilds the grid, so it can't be claimed in the meantime.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    /// \return a copy of the cell's particle.
+    ParticleComponent remove(const int& x, const int& y);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Reuse the storage of particles removed before the last grid
+    ///         rebuild, once no cell refers to it any longer.
+    void reclaimSlots();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Ask for static cells to be returned to the world, as particles
+    ///         tried to displace them. Parallel passes gather a list per
+    ///         thread and hand each over once they joined.
+    /// \param  cells   the cells to return.
+    void requestDemotions(const Demotions& cells);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the cells asked to be returned to the world.
+    /// \return reference to the pending requests, for the caller to clear.
+    [[nodiscard]] Demotions& getDemotions() noexcept { return m_demotions; }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Check if a cell belongs to the layer.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row.
+    /// \return true if the cell is static.
+    [[nodiscard]] bool test(const int& x, const int& y) const noexcept {
+        return m_mask.test(x, y);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the particle of a static cell.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row, the cell must be static.
+    /// \return reference to the cell's particle.
+    [[nodiscard]] const ParticleComponent&
+    get(const int& x, const int& y) const noexcept {
+        return *m_particleArray[y][x];
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the bits marking static cells.
+    /// \return reference to the layer's mask.
+    [[nodiscard]] const OccupancyGrid& getMask() const noexcept {
+        return m_mask;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of static cells.
+    /// \return the number of particles in the layer.
+    [[nodiscard]] size_t size() const noexcept { return m_count; }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Validate the guard band, for debug checks: every ring cell
+    ///         holds a static wall and nothing occupies the padding past it.
+    /// \return true if neighbour reads from the play area stay in bounds.
+    [[nodiscard]] bool guardBandIntact() const noexcept;
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the layer packed for rendering, re-packing it only
+    ///         if it changed since the last call.
+    /// \return reference to the layer's GPU renderable particles.
+    [[nodiscard]] const std::vector<GPU_Particle>& getPacked();
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    std::shared_ptr<ParticleComponent* [513][513]>& m_particleArray;
+    OccupancyGrid& m_occupancy;
+    OccupancyGrid m_mask;                      ///< Bits marking static cells.
+    size_t m_count = 0ULL;                     ///< Number of static cells.
+    std::deque<ParticleComponent> m_particles; ///< Stable particle storage.
+    std::vector<ParticleComponent*> m_freeSlots; ///< Storage free for reuse.
+    std::vector<ParticleComponent*>
+        m_removedSlots; ///< Storage still referenced until the next rebuild.
+    Demotions m_demotions;              ///< Cells to demote.
+    std::vector<GPU_Particle> m_packed; ///< Cached render data.
+    bool m_dirty = true; ///< True if the render data must be re-packed.
+};
+
+#endif // STATICLAYER_HPP
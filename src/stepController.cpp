@@ -0,0 +1,54 @@
+#include "stepController.hpp"
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+StepController::StepController(
+    const double& timeStep, const size_t& maxSubsteps,
+    const bool& timeDilation) noexcept
+    : m_timeStep(timeStep), m_maxSubsteps(std::max<size_t>(maxSubsteps, 1ULL)),
+      m_timeDilation(timeDilation) {}
+
+//////////////////////////////////////////////////////////////////////
+/// beginFrame
+//////////////////////////////////////////////////////////////////////
+
+size_t StepController::beginFrame(const double& deltaTime) noexcept {
+    // Steps kept back by earlier frames run first, each of them late
+    const auto carriedSteps = static_cast<size_t>(m_accumulator / m_timeStep);
+    m_accumulator += deltaTime;
+    const auto pendingSteps = static_cast<size_t>(m_accumulator / m_timeStep);
+    const auto steps = std::min(pendingSteps, m_maxSubsteps);
+    m_accumulator -= static_cast<double>(steps) * m_timeStep;
+
+    if (pendingSteps > m_maxSubsteps) {
+        // Either drop the excess outright, or keep a bounded backlog of it
+        const size_t maxBacklog = m_timeDilation ? 0ULL : m_maxSubsteps * 4ULL;
+        const auto backlog = pendingSteps - steps;
+        if (backlog > maxBacklog) {
+            const auto dropped = backlog - maxBacklog;
+            m_accumulator -= static_cast<double>(dropped) * m_timeStep;
+            m_metrics.droppedSteps += dropped;
+        }
+    }
+
+    m_metrics.totalSteps += steps;
+    m_metrics.lateSteps += std::min(steps, carriedSteps);
+    m_metrics.lastFrameSteps = steps;
+    m_metrics.pendingSteps = static_cast<size_t>(m_accumulator / m_timeStep);
+    m_metrics.timeScale = deltaTime > 0.0
+                              ? static_cast<double>(steps) * m_timeStep /
+                                    deltaTime
+                              : 1.0;
+    return steps;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// setMaxSubsteps
+//////////////////////////////////////////////////////////////////////
+
+void StepController::setMaxSubsteps(const size_t& maxSubsteps) noexcept {
+    m_maxSubsteps = std::max<size_t>(maxSubsteps, 1ULL);
+}
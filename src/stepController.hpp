@@ -0,0 +1,94 @@
+#pragma once
+#ifndef STEPCONTROLLER_HPP
+#define STEPCONTROLLER_HPP
+
+#include <cstddef>
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  StepController
+/// \brief  Decides how many fixed steps to simulate each frame.
+///         Caps the number of sub-steps per frame so that a slow frame
+///         can't snowball into ever slower frames, and tracks the steps
+///         it had to drop or delay.
+class StepController {
+    public:
+    /////////////////////////////////////////////////////////////////////////
+    /// \struct Metrics
+    /// \brief  Statistics describing how well the simulation keeps up.
+    struct Metrics {
+        size_t totalSteps = 0ULL;     ///< Steps simulated so far.
+        size_t droppedSteps = 0ULL;   ///< Steps discarded while overloaded.
+        size_t lateSteps = 0ULL;      ///< Steps run a frame or more late.
+        size_t lastFrameSteps = 0ULL; ///< Steps simulated last frame.
+        size_t pendingSteps = 0ULL;   ///< Whole steps left to catch up on.
+        double timeScale = 1.0; ///< Simulated time over real time last frame.
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a step controller.
+    /// \param  timeStep        the duration of a single fixed step.
+    /// \param  maxSubsteps     the most steps to simulate in one frame.
+    /// \param  timeDilation    drop steps beyond the cap, slowing time.
+    explicit StepController(
+        const double& timeStep = 0.025, const size_t& maxSubsteps = 4ULL,
+        const bool& timeDilation = true) noexcept;
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Accumulate a frame's worth of time.
+    /// \param  deltaTime   the amount of time since last frame.
+    /// \return the number of fixed steps to simulate this frame.
+    size_t beginFrame(const double& deltaTime) noexcept;
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the duration of a single fixed step.
+    /// \return the fixed time step.
+    [[nodiscard]] double getTimeStep() const noexcept { return m_timeStep; }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the fraction of a step left in the accumulator.
+    /// \return interpolation factor between the last two steps.
+    [[nodiscard]] double getAlpha() const noexcept {
+        return m_accumulator / m_timeStep;
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the statistics gathered so far.
+    /// \return the step metrics.
+    [[nodiscard]] const Metrics& getMetrics() const noexcept {
+        return m_metrics;
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Check whether fusing pending steps is allowed.
+    /// \return true if entity cleanup runs once per frame, not per step.
+    [[nodiscard]] bool getStepFusion() const noexcept { return m_stepFusion; }
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Set the most steps to simulate in one frame.
+    /// \param  maxSubsteps     the sub-step cap, at least 1.
+    void setMaxSubsteps(const size_t& maxSubsteps) noexcept;
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Set whether steps beyond the cap are dropped.
+    /// \param  timeDilation    true to slow time down when overloaded,
+    ///                         false to catch up over the following frames.
+    void setTimeDilation(const bool& timeDilation) noexcept {
+        m_timeDilation = timeDilation;
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Set whether entity cleanup runs once per frame, not per step.
+    ///         Fused, particles that die mid-frame linger for the frame's
+    ///         remaining steps, so runs no longer match unfused ones.
+    /// \param  stepFusion  true to fuse pending steps where possible.
+    void setStepFusion(const bool& stepFusion) noexcept {
+        m_stepFusion = stepFusion;
+    }
+
+    private:
+    /////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    double m_timeStep = 0.025;   ///< Duration of a single step.
+    double m_accumulator = 0.0;  ///< Time left in the accumulator.
+    size_t m_maxSubsteps = 4ULL; ///< Most steps to simulate per frame.
+    bool m_timeDilation = true;  ///< Drop steps beyond the cap.
+    bool m_stepFusion = false;   ///< Fuse pending steps where possible.
+    Metrics m_metrics;           ///< Statistics gathered so far.
+};
+
+#endif // STEPCONTROLLER_HPP
@@ -0,0 +1,97 @@
+#include "systemScheduler.hpp"
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+SystemScheduler::SystemScheduler(
+    ThreadPool& threadPool, Profiler& profiler) noexcept
+    : m_threadPool(threadPool), m_profiler(profiler) {}
+
+//////////////////////////////////////////////////////////////////////
+/// addTask
+//////////////////////////////////////////////////////////////////////
+
+void SystemScheduler::addTask(
+    const std::string& name, const std::uint32_t& reads,
+    const std::uint32_t& writes, std::function<void()>&& func) {
+    auto& task = m_tasks.emplace_back();
+    task.name = name;
+    task.reads = reads;
+    task.writes = writes;
+    task.func = std::move(func);
+    task.zone = &m_profiler.addZone(name);
+
+    // Wait on every earlier task it conflicts with, the graph never changes
+    const auto index = m_tasks.size() - 1ULL;
+    for (size_t x = 0ULL; x < index; ++x) {
+        auto& parent = m_tasks[x];
+        if ((parent.writes & (reads | writes)) != 0U ||
+            (parent.reads & writes) != 0U) {
+            parent.children.emplace_back(index);
+            ++task.parentCount;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// run
+//////////////////////////////////////////////////////////////////////
+
+void SystemScheduler::run() {
+    // Start every task without dependencies, then help until all finished
+    const auto taskCount = m_tasks.size();
+    m_remaining = taskCount;
+    for (auto& task : m_tasks)
+        task.waiting = task.parentCount;
+    for (size_t x = 0ULL; x < taskCount; ++x)
+        if (m_tasks[x].parentCount == 0ULL)
+            launch(x);
+    m_threadPool.wait(m_remaining);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// isOrdered
+//////////////////////////////////////////////////////////////////////
+
+bool SystemScheduler::isOrdered(
+    const std::string& first, const std::string& second) const {
+    const auto indexOf = [&](const std::string& name) {
+        size_t index = 0ULL;
+        while (index < m_tasks.size() && m_tasks[index].name != name)
+            ++index;
+        return index;
+    };
+    const auto from = indexOf(first);
+    const auto to = indexOf(second);
+    if (from >= to || to == m_tasks.size())
+        return false;
+
+    // Children always follow their parents, so one sweep finds every path
+    std::vector<bool> reached(to + 1ULL, false);
+    reached[from] = true;
+    for (size_t x = from; x < to; ++x)
+        if (reached[x])
+            for (const auto& child : m_tasks[x].children)
+                if (child <= to)
+                    reached[child] = true;
+    return reached[to];
+}
+
+//////////////////////////////////////////////////////////////////////
+/// launch
+//////////////////////////////////////////////////////////////////////
+
+void SystemScheduler::launch(const size_t& index) {
+    m_threadPool.submit([&, index] {
+        auto& task = m_tasks[index];
+        {
+            const Profiler::Scope scope(task.zone);
+            task.func();
+        }
+        for (const auto& child : task.children)
+            if (--m_tasks[child].waiting == 0ULL)
+                launch(child);
+        --m_remaining;
+    });
+}
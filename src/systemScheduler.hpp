@@ -0,0 +1,97 @@
+#pragma once
+#ifndef SYSTEMSCHEDULER_HPP
+#define SYSTEMSCHEDULER_HPP
+
+#include "profiler.hpp"
+#include "threadPool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  SystemScheduler
+/// \brief  Runs a step's systems concurrently where their data allows it.
+///         Each task declares the resources it reads and writes. A task
+///         waits on every earlier task it conflicts with, independent tasks
+///         run at the same time on a shared thread pool.
+class SystemScheduler {
+    public:
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Resources tasks may read or write, combined as bit flags.
+    enum Resource : std::uint32_t {
+        ENTITIES = 1U << 0U,   ///< Entity and component lists of the world.
+        PARTICLES = 1U << 1U,  ///< Particle components.
+        FIRE = 1U << 2U,       ///< Flammable, explosive & on-fire components.
+        MANIFOLDS = 1U << 3U,  ///< Collision manifold components.
+        SPAWNERS = 1U << 4U,   ///< Spawner components.
+        GRID = 1U << 5U,       ///< The particle array and its cell bits.
+        BURN_TIMERS = 1U << 6U, ///< Burn-out timers.
+        FUSE_TIMERS = 1U << 7U, ///< Detonation timers.
+        HEAT = 1U << 8U,        ///< The temperature of each cell.
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a system scheduler.
+    /// \param  threadPool  the pool to run tasks on.
+    /// \param  profiler    the profiler to attribute each task's
+    ///                     allocations to.
+    SystemScheduler(ThreadPool& threadPool, Profiler& profiler) noexcept;
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Add a task to run every step, after all earlier added tasks
+    ///         it conflicts with. Its dependencies are worked out once, here.
+    /// \param  name    the name of the task, and of its profiler zone.
+    /// \param  reads   the resources the task reads.
+    /// \param  writes  the resources the task writes.
+    /// \param  func    the task to run.
+    void addTask(
+        const std::string& name, const std::uint32_t& reads,
+        const std::uint32_t& writes, std::function<void()>&& func);
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Run all tasks once, returning when they all finished.
+    void run();
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Check whether one task always finishes before another starts.
+    /// \param  first   the name of the earlier added task.
+    /// \param  second  the name of the later added task.
+    /// \return true if the second task waits on the first, directly or
+    ///         through other tasks, false if they may run at the same time.
+    [[nodiscard]] bool
+    isOrdered(const std::string& first, const std::string& second) const;
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the thread pool tasks run on.
+    /// \return reference to the scheduler's thread pool.
+    [[nodiscard]] ThreadPool& getThreadPool() noexcept { return m_threadPool; }
+
+    private:
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Submit a task whose dependencies finished to the pool.
+    /// \param  index   the index of the task to run.
+    void launch(const size_t& index);
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \struct Task
+    /// \brief  A task and its place within the step's dependency graph.
+    struct Task {
+        std::string name;             ///< Name of this task.
+        std::uint32_t reads = 0U;     ///< Resources this task reads.
+        std::uint32_t writes = 0U;    ///< Resources this task writes.
+        std::function<void()> func;   ///< The task to run.
+        Profiler::Zone* zone = nullptr; ///< Zone of this task.
+        std::vector<size_t> children; ///< Tasks waiting on this task.
+        size_t parentCount = 0ULL;    ///< Tasks this task waits on.
+        std::atomic<size_t> waiting{ 0ULL }; ///< Unfinished parents.
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    ThreadPool& m_threadPool;             ///< Pool running the tasks.
+    Profiler& m_profiler;                 ///< Profiler holding task zones.
+    std::deque<Task> m_tasks;             ///< Tasks in the order added.
+    std::atomic<size_t> m_remaining{ 0ULL }; ///< Unfinished tasks this run.
+};
+
+#endif // SYSTEMSCHEDULER_HPP
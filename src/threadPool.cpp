@@ -0,0 +1,155 @@
+#include "threadPool.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+
+//////////////////////////////////////////////////////////////////////
+/// Index of the calling thread's queue within its pool, if a worker
+static thread_local const ThreadPool* t_pool = nullptr;
+static thread_local size_t t_queueIndex = 0ULL;
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+ThreadPool::ThreadPool(const size_t& threadCount) {
+    // One queue per worker, plus one shared by all other threads
+    m_queues.reserve(threadCount + 1ULL);
+    for (size_t x = 0ULL; x < threadCount + 1ULL; ++x)
+        m_queues.emplace_back(std::make_unique<TaskQueue>());
+    m_threads.reserve(threadCount);
+    for (size_t x = 0ULL; x < threadCount; ++x)
+        m_threads.emplace_back(&ThreadPool::workerLoop, this, x);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// Destructor
+//////////////////////////////////////////////////////////////////////
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_running = false;
+    }
+    m_wakeCondition.notify_all();
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// submit
+//////////////////////////////////////////////////////////////////////
+
+void ThreadPool::submit(std::function<void()>&& task) {
+#ifdef TRACK_ALLOCATIONS
+    // Attribute the task's allocations to the zone submitting it, without
+    // counting the wrapper itself
+    auto* zone = Profiler::currentZone();
+    {
+        const Profiler::Scope untracked(nullptr);
+        task = [zone, func = std::move(task)] {
+            const Profiler::Scope scope(zone);
+            func();
+        };
+    }
+#endif
+    // Workers queue onto their own queue, everyone else onto the shared one
+    const auto index = t_pool == this ? t_queueIndex : m_threads.size();
+    {
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        ++m_pendingTasks;
+    }
+    {
+        auto& queue = *m_queues[index];
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        queue.tasks.emplace_back(std::move(task));
+    }
+    m_wakeCondition.notify_one();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// parallelFor
+//////////////////////////////////////////////////////////////////////
+
+void ThreadPool::parallelFor(
+    const size_t& begin, const size_t& end, const size_t& grain,
+    const std::function<void(size_t, size_t)>& func) {
+    const auto chunkSize = std::max<size_t>(grain, 1ULL);
+    std::atomic<size_t> remaining{ 0ULL };
+    for (auto start = begin; start < end; start += chunkSize) {
+        const auto stop = std::min(start + chunkSize, end);
+        ++remaining;
+        submit([&func, &remaining, start, stop] {
+            func(start, stop);
+            --remaining;
+        });
+    }
+    wait(remaining);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// wait
+//////////////////////////////////////////////////////////////////////
+
+void ThreadPool::wait(const std::atomic<size_t>& counter) {
+    while (counter.load(std::memory_order_acquire) > 0ULL)
+        if (!runPendingTask())
+            std::this_thread::yield();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// defaultThreadCount
+//////////////////////////////////////////////////////////////////////
+
+size_t ThreadPool::defaultThreadCount() noexcept {
+    const auto cores = static_cast<size_t>(std::thread::hardware_concurrency());
+    return cores > 1ULL ? cores - 1ULL : 0ULL;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// runPendingTask
+//////////////////////////////////////////////////////////////////////
+
+bool ThreadPool::runPendingTask() {
+    std::function<void()> task;
+    const auto queueCount = m_queues.size();
+    const auto ownIndex = t_pool == this ? t_queueIndex : queueCount - 1ULL;
+
+    // Take the newest task of our own queue, else steal the oldest of others
+    for (size_t offset = 0ULL; offset < queueCount && !task; ++offset) {
+        auto& queue = *m_queues[(ownIndex + offset) % queueCount];
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+        if (offset == 0ULL) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+    if (!task)
+        return false;
+
+    --m_pendingTasks;
+    task();
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// workerLoop
+//////////////////////////////////////////////////////////////////////
+
+void ThreadPool::workerLoop(const size_t& index) {
+    t_pool = this;
+    t_queueIndex = index;
+    while (m_running) {
+        if (runPendingTask())
+            continue;
+
+        // Sleep until more work is submitted
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.wait(
+            lock, [&] { return !m_running || m_pendingTasks > 0ULL; });
+    }
+}
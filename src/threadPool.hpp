@@ -0,0 +1,100 @@
+#pragma once
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  ThreadPool
+/// \brief  A work-stealing pool of worker threads.
+///         Each worker owns a task queue, taking its newest tasks first and
+///         stealing the oldest tasks of others when it runs dry. Threads
+///         waiting on tasks help run them rather than block.
+class ThreadPool {
+    public:
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Stop and join all worker threads.
+    ~ThreadPool();
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Deleted copy constructor.
+    ThreadPool(const ThreadPool& o) = delete;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Deleted move constructor.
+    ThreadPool(ThreadPool&& o) noexcept = delete;
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a thread pool.
+    /// \param  threadCount     the number of worker threads to spawn.
+    explicit ThreadPool(const size_t& threadCount = defaultThreadCount());
+
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Deleted copy-assignment operator.
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    //////////////////////////////////////////////////////////////////////
+    /// \brief  Deleted move-assignment operator.
+    ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Queue a task to be run by the pool.
+    /// \param  task    the task to run.
+    void submit(std::function<void()>&& task);
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Run a function over a range in parallel, returning when done.
+    /// \param  begin   the start of the range.
+    /// \param  end     the end of the range.
+    /// \param  grain   the most elements per task.
+    /// \param  func    function taking the start and end of a sub-range.
+    void parallelFor(
+        const size_t& begin, const size_t& end, const size_t& grain,
+        const std::function<void(size_t, size_t)>& func);
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Run queued tasks until a counter reaches zero.
+    /// \param  counter     the number of unfinished tasks to wait on.
+    void wait(const std::atomic<size_t>& counter);
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of worker threads.
+    /// \return the number of worker threads.
+    [[nodiscard]] size_t getThreadCount() const noexcept {
+        return m_threads.size();
+    }
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve a worker count leaving a core for the calling thread.
+    /// \return the default number of worker threads.
+    [[nodiscard]] static size_t defaultThreadCount() noexcept;
+
+    private:
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Run a single queued task, if there is one.
+    /// \return true if a task was run, false otherwise.
+    bool runPendingTask();
+    /////////////////////////////////////////////////////////////////////////
+    /// \brief  Loop run by every worker thread.
+    /// \param  index   the index of the worker's task queue.
+    void workerLoop(const size_t& index);
+
+    /////////////////////////////////////////////////////////////////////////
+    /// \struct TaskQueue
+    /// \brief  A task queue owned by a single thread.
+    struct TaskQueue {
+        std::mutex mutex;                        ///< Guards the tasks.
+        std::deque<std::function<void()>> tasks; ///< Queued tasks.
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    std::vector<std::unique_ptr<TaskQueue>>
+        m_queues;                        ///< Per worker queues, then shared.
+    std::vector<std::thread> m_threads;  ///< Worker threads.
+    std::atomic<size_t> m_pendingTasks{ 0ULL }; ///< Queued task count.
+    std::atomic_bool m_running{ true };         ///< Keep workers running.
+    std::mutex m_wakeMutex;                     ///< Guards sleeping workers.
+    std::condition_variable m_wakeCondition;    ///< Wakes sleeping workers.
+};
+
+#endif // THREADPOOL_HPP
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef TIMERWHEEL_HPP
+#define TIMERWHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  TimerWheel
+/// \brief  A hierarchical timer wheel, scheduling objects by step number.
+///         Timers land in a fine wheel of single steps, a coarse wheel of
+///         SLOTS steps per slot, or an overflow list, and cascade towards
+///         the fine wheel as time advances. Advancing costs work
+///         proportional to the number of expiring timers.
+/// \tparam T   The type of object to schedule.
+template <typename T> class TimerWheel {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  The number of slots per wheel level.
+    static constexpr size_t SLOTS = 256ULL;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Schedule an object to expire a number of steps from now.
+    /// \param  obj     the object to schedule.
+    /// \param  delay   the number of steps until expiry, at least 1.
+    void schedule(const T& obj, const size_t& delay) {
+        const auto expiry = m_step + std::max<size_t>(delay, 1ULL);
+        insert(expiry, obj);
+        ++m_count;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Advance the wheel by a single step, expiring due timers.
+    /// \param  func    function invoked with each expired object.
+    template <typename Func> void advance(Func&& func) {
+        ++m_step;
+
+        // Cascade the coarse wheel into the fine wheel on each revolution
+        if (m_step % SLOTS == 0ULL) {
+            // Pull overflowing timers into the coarse wheel per revolution
+            if (m_step % (SLOTS * SLOTS) == 0ULL) {
+                auto overflow = std::move(m_overflow);
+                m_overflow.clear();
+                for (const auto& [expiry, obj] : overflow)
+                    insert(expiry, obj);
+            }
+            auto& coarseSlot = m_coarse[(m_step / SLOTS) % SLOTS];
+            for (const auto& [expiry, obj] : coarseSlot)
+                insert(expiry, obj);
+            coarseSlot.clear();
+        }
+
+        // Expire every timer in the current fine slot
+        auto& fineSlot = m_fine[m_step % SLOTS];
+        for (const auto& timer : fineSlot)
+            func(timer.second);
+        m_count -= fineSlot.size();
+        fineSlot.clear();
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the current step of this wheel.
+    /// \return the number of steps advanced so far.
+    [[nodiscard]] size_t step() const noexcept { return m_step; }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the number of pending timers.
+    /// \return the number of scheduled, un-expired timers.
+    [[nodiscard]] size_t size() const noexcept { return m_count; }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Place a timer into the level matching its remaining time.
+    /// \param  expiry  the step the timer expires on.
+    /// \param  obj     the object to schedule.
+    void insert(const size_t& expiry, const T& obj) {
+        if (expiry / SLOTS == m_step / SLOTS)
+            m_fine[expiry % SLOTS].emplace_back(expiry, obj);
+        else if (expiry / (SLOTS * SLOTS) == m_step / (SLOTS * SLOTS))
+            m_coarse[(expiry / SLOTS) % SLOTS].emplace_back(expiry, obj);
+        else
+            m_overflow.emplace_back(expiry, obj);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    using Timer = std::pair<size_t, T>;
+    std::array<std::vector<Timer>, SLOTS> m_fine;   ///< Single step slots.
+    std::array<std::vector<Timer>, SLOTS> m_coarse; ///< SLOTS step slots.
+    std::vector<Timer> m_overflow; ///< Timers beyond the coarse wheel.
+    size_t m_step = 0ULL;          ///< The current step.
+    size_t m_count = 0ULL;         ///< The number of pending timers.
+};
+
+#endif // TIMERWHEEL_HPP
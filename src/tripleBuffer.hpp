@@ -0,0 +1,59 @@
+#pragma once
+#ifndef TRIPLEBUFFER_HPP
+#define TRIPLEBUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  TripleBuffer
+/// \brief  Lock-free hand-off of data from one writer thread to one reader.
+///         The writer fills its own buffer and publishes it, the reader
+///         consumes the most recently published buffer. Neither side ever
+///         waits on the other, stale buffers are simply overwritten.
+/// \tparam T   The type of data to exchange.
+template <typename T> class TripleBuffer {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the buffer owned by the writer.
+    /// \return reference to the buffer to fill.
+    [[nodiscard]] T& getWriteBuffer() noexcept {
+        return m_buffers[m_writeIndex];
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Publish the write buffer, making it the latest for the reader.
+    void publish() noexcept {
+        m_writeIndex = m_middle.exchange(
+                           m_writeIndex | DIRTY, std::memory_order_acq_rel) &
+                       INDEX;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Acquire the latest published buffer, if there is a new one.
+    /// \return true if the read buffer changed, false otherwise.
+    bool consume() noexcept {
+        if ((m_middle.load(std::memory_order_relaxed) & DIRTY) == 0U)
+            return false;
+        m_readIndex =
+            m_middle.exchange(m_readIndex, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the buffer owned by the reader.
+    /// \return reference to the latest consumed buffer.
+    [[nodiscard]] const T& getReadBuffer() const noexcept {
+        return m_buffers[m_readIndex];
+    }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    static constexpr std::uint8_t INDEX = 0b011U; ///< Mask for buffer index.
+    static constexpr std::uint8_t DIRTY = 0b100U; ///< Flags a new buffer.
+    std::array<T, 3> m_buffers;                   ///< The three buffers.
+    std::uint8_t m_writeIndex = 0U;               ///< Writer's buffer.
+    std::uint8_t m_readIndex = 1U;                ///< Reader's buffer.
+    std::atomic<std::uint8_t> m_middle{ 2U };     ///< Exchanged buffer.
+};
+
+#endif // TRIPLEBUFFER_HPP
@@ -0,0 +1,296 @@
+#include "worldBuilder.hpp"
+#include "guardBand.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+//////////////////////////////////////////////////////////////////////
+/// \class  MaterialMapParser
+/// \brief  Parses the header and samples of a PGM or PPM image.
+class MaterialMapParser {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a parser over the bytes of an image file.
+    /// \param  bytes   the file's contents.
+    explicit MaterialMapParser(const std::string& bytes) : m_bytes(bytes) {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse the whole image.
+    /// \param  error   set to a description of the problem on failure.
+    /// \return a descriptor for each non-empty pixel, or nothing on failure.
+    std::optional<std::vector<ParticleDescriptor>> parse(std::string& error) {
+        std::vector<ParticleDescriptor> descriptors;
+        if (!parseImage(descriptors)) {
+            error = m_error;
+            return {};
+        }
+        return descriptors;
+    }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse the header, then hand each pixel to its material.
+    /// \param  descriptors the descriptors to fill.
+    /// \return true on success, false otherwise.
+    bool parseImage(std::vector<ParticleDescriptor>& descriptors) {
+        if (m_bytes.size() < 2ULL || m_bytes[0] != 'P')
+            return fail("not a PGM or PPM image");
+        const char format = m_bytes[1];
+        m_plain = format == '2' || format == '3';
+        m_channels = format == '3' || format == '6' ? 3 : 1;
+        if (!m_plain && format != '5' && format != '6')
+            return fail(std::string("unsupported image format P") + format);
+        m_pos = 2ULL;
+
+        int width = 0;
+        int height = 0;
+        int maxValue = 0;
+        if (!parseHeaderValue(width) || !parseHeaderValue(height) ||
+            !parseHeaderValue(maxValue))
+            return false;
+        if (width <= 0 || height <= 0)
+            return fail("image has no pixels");
+        if (maxValue <= 0 || maxValue > 255)
+            return fail("only 8-bit images are supported");
+        // Binary samples start after a single whitespace byte
+        if (!m_plain)
+            ++m_pos;
+
+        // Every sample takes a byte, plain ones a separator too, so bogus
+        // dimensions are caught before allocating anything
+        const auto samples = static_cast<size_t>(width) *
+                             static_cast<size_t>(height) *
+                             static_cast<size_t>(m_channels);
+        const size_t sampleBytes = m_plain ? 2ULL : 1ULL;
+        if (m_pos > m_bytes.size() ||
+            samples > (m_bytes.size() - m_pos) / sampleBytes)
+            return fail("image data is shorter than its dimensions");
+
+        const auto palette = makePalette(maxValue);
+        constexpr int playSize = playMax - playMin + 1;
+        descriptors.reserve(
+            static_cast<size_t>(std::min(width, playSize)) *
+            static_cast<size_t>(std::min(height, playSize)));
+        for (int row = 0; row < height; ++row) {
+            for (int column = 0; column < width; ++column) {
+                std::array<int, 3> pixel{};
+                for (int channel = 0; channel < m_channels; ++channel)
+                    if (!parseSample(pixel[channel], maxValue))
+                        return false;
+
+                const auto material = m_channels == 1
+                                          ? findGreyMaterial(pixel[0])
+                                          : findColourMaterial(pixel, palette);
+                if (!material)
+                    return fail(
+                        "grey level " + std::to_string(pixel[0]) +
+                        " isn't a material");
+                if (*material != Material::NONE && column < playSize &&
+                    row < playSize)
+                    descriptors.push_back(
+                        { *material, playMin + column, playMax - row });
+            }
+        }
+        return true;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse a number of the header, skipping whitespace and comments.
+    /// \param  value   set to the number.
+    /// \return true on success, false otherwise.
+    bool parseHeaderValue(int& value) {
+        while (m_pos < m_bytes.size()) {
+            if (m_bytes[m_pos] == '#')
+                while (m_pos < m_bytes.size() && m_bytes[m_pos] != '\n')
+                    ++m_pos;
+            else if (std::isspace(static_cast<unsigned char>(m_bytes[m_pos])))
+                ++m_pos;
+            else
+                break;
+        }
+        return parseNumber(value) || fail("truncated image header");
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse a sample of the raster.
+    /// \param  value       set to the sample.
+    /// \param  maxValue    the largest sample allowed.
+    /// \return true on success, false otherwise.
+    bool parseSample(int& value, const int& maxValue) {
+        if (m_plain) {
+            while (m_pos < m_bytes.size() &&
+                   std::isspace(static_cast<unsigned char>(m_bytes[m_pos])))
+                ++m_pos;
+            if (!parseNumber(value))
+                return fail("truncated image data");
+        } else {
+            if (m_pos >= m_bytes.size())
+                return fail("truncated image data");
+            value = static_cast<unsigned char>(m_bytes[m_pos++]);
+        }
+        return value <= maxValue || fail("sample exceeds the image's maximum");
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse a decimal number at the current position.
+    /// \param  value   set to the number.
+    /// \return true if digits were found and fit an int, false otherwise.
+    bool parseNumber(int& value) {
+        const auto start = m_pos;
+        value = 0;
+        while (m_pos < m_bytes.size() &&
+               std::isdigit(static_cast<unsigned char>(m_bytes[m_pos]))) {
+            const int digit = m_bytes[m_pos++] - '0';
+            if (value > (std::numeric_limits<int>::max() - digit) / 10)
+                return fail("number too large");
+            value = value * 10 + digit;
+        }
+        return m_pos != start;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Scale each material's colour to the image's sample range.
+    /// \param  maxValue    the largest sample of the image.
+    /// \return the colour of each material, black for Material::NONE.
+    static std::array<std::array<int, 3>, materialCount>
+    makePalette(const int& maxValue) {
+        std::array<std::array<int, 3>, materialCount> palette{};
+        for (size_t material = 1ULL; material < materialCount; ++material) {
+            const auto color =
+                makePreset(static_cast<Material>(material)).particle.m_color;
+            const auto scale = [&](const float& channel) {
+                return static_cast<int>(
+                    std::lround(channel * static_cast<float>(maxValue)));
+            };
+            palette[material] = { scale(color.x()), scale(color.y()),
+                                  scale(color.z()) };
+        }
+        return palette;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Find the material a grey level names.
+    /// \param  grey    the pixel's grey level.
+    /// \return the material, or nothing if no material has that number.
+    static std::optional<Material> findGreyMaterial(const int& grey) {
+        if (grey < 0 || static_cast<size_t>(grey) >= materialCount)
+            return {};
+        return static_cast<Material>(grey);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Find the material whose colour is nearest a pixel's.
+    /// \param  pixel   the pixel's colour.
+    /// \param  palette the colour of each material.
+    /// \return the nearest material, Material::NONE for black.
+    static std::optional<Material> findColourMaterial(
+        const std::array<int, 3>& pixel,
+        const std::array<std::array<int, 3>, materialCount>& palette) {
+        if (pixel[0] == 0 && pixel[1] == 0 && pixel[2] == 0)
+            return Material::NONE;
+        size_t nearest = 1ULL;
+        int nearestDistance = std::numeric_limits<int>::max();
+        for (size_t material = 1ULL; material < materialCount; ++material) {
+            int distance = 0;
+            for (int channel = 0; channel < 3; ++channel) {
+                const int delta = pixel[channel] - palette[material][channel];
+                distance += delta * delta;
+            }
+            if (distance < nearestDistance) {
+                nearest = material;
+                nearestDistance = distance;
+            }
+        }
+        return static_cast<Material>(nearest);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Record a problem with the image.
+    /// \param  message the problem.
+    /// \return false.
+    bool fail(const std::string& message) {
+        if (m_error.empty())
+            m_error = message;
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    const std::string& m_bytes; ///< The file's contents.
+    size_t m_pos = 0ULL;        ///< Index of the next byte to read.
+    bool m_plain = false;       ///< True if samples are written as text.
+    int m_channels = 1;         ///< Samples per pixel.
+    std::string m_error;        ///< The first problem found.
+};
+
+//////////////////////////////////////////////////////////////////////
+/// Custom Constructor
+//////////////////////////////////////////////////////////////////////
+
+WorldBuilder::WorldBuilder(
+    ecsWorld& gameWorld, OccupancyGrid& occupancy, StaticLayer& staticLayer)
+    : m_gameWorld(gameWorld), m_occupancy(occupancy),
+      m_staticLayer(staticLayer) {
+    for (size_t material = 0ULL; material < materialCount; ++material)
+        m_presets[material] = makePreset(static_cast<Material>(material));
+}
+
+//////////////////////////////////////////////////////////////////////
+/// build
+//////////////////////////////////////////////////////////////////////
+
+size_t WorldBuilder::build(
+    const ParticleDescriptor* descriptors, const size_t& count) {
+    size_t built = 0ULL;
+    for (size_t index = 0ULL; index < count; ++index) {
+        const auto& [material, x, y] = descriptors[index];
+#ifdef DEBUG
+        assert(static_cast<size_t>(material) < materialCount);
+#endif
+        if (material == Material::NONE || !inPlayArea(x, y) ||
+            m_occupancy.test(x, y))
+            continue;
+
+        // Copy the material's components, placed at the descriptor's cell
+        auto& preset = m_presets[static_cast<size_t>(material)];
+        ParticleComponent particle = preset.particle;
+        particle.m_pos = vec2(static_cast<float>(x), static_cast<float>(y));
+        ++built;
+        if (!particle.m_useGravity) {
+            m_staticLayer.add(particle);
+            continue;
+        }
+
+        // Claim the cell until the collision system next rebuilds the grid
+        m_occupancy.set(x, y);
+        const auto handle = m_gameWorld.makeEntity();
+        m_gameWorld.makeComponent(handle, &particle);
+        if ((particle.m_state & ParticleComponent::FLAMMABLE) != 0U)
+            m_gameWorld.makeComponent(handle, &preset.flammable);
+        if ((particle.m_state & ParticleComponent::EXPLOSIVE) != 0U)
+            m_gameWorld.makeComponent(handle, &preset.explosive);
+    }
+    return built;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// parseMaterialMap
+//////////////////////////////////////////////////////////////////////
+
+std::optional<std::vector<ParticleDescriptor>>
+parseMaterialMap(const std::string& bytes, std::string& error) {
+    return MaterialMapParser(bytes).parse(error);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// loadMaterialMap
+//////////////////////////////////////////////////////////////////////
+
+std::optional<std::vector<ParticleDescriptor>>
+loadMaterialMap(const std::string& path, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "can't open " + path;
+        return {};
+    }
+    std::stringstream bytes;
+    bytes << file.rdbuf();
+    return parseMaterialMap(bytes.str(), error);
+}
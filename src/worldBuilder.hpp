@@ -0,0 +1,96 @@
+#pragma once
+#ifndef WORLDBUILDER_HPP
+#define WORLDBUILDER_HPP
+
+#include "bitboard.hpp"
+#include "components.hpp"
+#include "ecsWorld.hpp"
+#include "materials.hpp"
+#include "particle.hpp"
+#include "staticLayer.hpp"
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+/////////////////////////////////////////////////////////////////////////
+/// \struct ParticleDescriptor
+/// \brief  A particle to create, by material and cell.
+struct ParticleDescriptor {
+    Material material = Material::NONE; ///< The particle's material.
+    int x = 0;                          ///< The particle's column.
+    int y = 0;                          ///< The particle's row.
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  WorldBuilder
+/// \brief  Creates many particles at once, as when loading a scene.
+///         Each material's components are built once per batch rather than
+///         per particle. Materials without gravity go straight into the
+///         static layer without an entity, the rest become entities whose
+///         cells are claimed until the collision system next rebuilds the
+///         grid.
+class WorldBuilder {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a builder over the simulation's world and grids.
+    /// \param  gameWorld       reference to the engine's game world.
+    /// \param  occupancy       bits marking the occupied particle cells.
+    /// \param  staticLayer     the layer holding particles without gravity.
+    WorldBuilder(
+        ecsWorld& gameWorld, OccupancyGrid& occupancy,
+        StaticLayer& staticLayer);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Create a particle for each descriptor, in a single pass.
+    ///         Descriptors outside the play area, of Material::NONE, or on a
+    ///         cell already taken are skipped, so the first one wins.
+    /// \param  descriptors the first particle to create.
+    /// \param  count       the number of particles to create.
+    /// \return the number of particles created.
+    size_t build(const ParticleDescriptor* descriptors, const size_t& count);
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Create a particle for each descriptor, in a single pass.
+    /// \param  descriptors the particles to create.
+    /// \return the number of particles created.
+    size_t build(const std::vector<ParticleDescriptor>& descriptors) {
+        return build(descriptors.data(), descriptors.size());
+    }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    ecsWorld& m_gameWorld;
+    OccupancyGrid& m_occupancy;
+    StaticLayer& m_staticLayer;
+    std::array<MaterialPreset, materialCount>
+        m_presets; ///< Starting components of each material.
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Parse a material map from the bytes of a PGM or PPM image,
+///         binary or plain. The image's top-left pixel maps to the top-left
+///         cell of the play area, pixels past the play area are skipped. A
+///         grey level names a material directly, 0 being empty; a colour
+///         maps to the material of the nearest colour, black being empty.
+/// \param  bytes   the image file's contents.
+/// \param  error   set to a description of the problem on failure.
+/// \return a descriptor for each non-empty pixel in the play area, or
+///         nothing if the image can't be parsed.
+std::optional<std::vector<ParticleDescriptor>>
+parseMaterialMap(const std::string& bytes, std::string& error);
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Read a material map from a PGM or PPM image, as parsed by
+///         parseMaterialMap.
+/// \param  path    the path to the image file.
+/// \param  error   set to a description of the problem on failure.
+/// \return a descriptor for each non-empty pixel, or nothing if the file
+///         can't be read or parsed.
+std::optional<std::vector<ParticleDescriptor>>
+loadMaterialMap(const std::string& path, std::string& error);
+
+#endif // WORLDBUILDER_HPP
@@ -0,0 +1,1042 @@
+#include "checkpoint.hpp"
+#include "heatField.hpp"
+#include "scenario.hpp"
+#include "systemScheduler.hpp"
+#include "timerWheel.hpp"
+#include "tripleBuffer.hpp"
+#include "worldBuilder.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////
+/// \struct CheckCase
+/// \brief  A named, deterministic check of the simulation's invariants.
+struct CheckCase {
+    std::string name;          ///< Name of the CTest case.
+    std::function<bool()> run; ///< Runs the check, true if it held.
+};
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Report a failed expectation.
+/// \param  holds   the expectation's outcome.
+/// \param  what    a description of what was expected.
+/// \return the expectation's outcome.
+static bool expect(const bool& holds, const std::string& what) {
+    if (!holds)
+        std::printf("  expected %s\n", what.c_str());
+    return holds;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// CollisionSystem::settledCellsAtRest
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Step a scenario until it settles, checking every step that the
+///         settled cells agree with the per-cell rule.
+/// \param  scenario    the particles to simulate.
+/// \param  steps       the number of steps to run.
+/// \return true if every step's settled cells were at rest.
+static bool checkSettledCells(Scenario scenario, const size_t& steps) {
+    scenario.linkComponents();
+    CollisionFixture fixture;
+    for (size_t step = 0ULL; step < steps; ++step) {
+        fixture.m_rng.setStep(step + 1ULL);
+        fixture.m_collision.updateComponents(0.025, scenario.m_components);
+        if (!expect(
+                fixture.m_collision.settledCellsAtRest(),
+                "settled cells at rest after step " + std::to_string(step)))
+            return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// CollisionSystem::applyMargolus
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Step a scenario by Margolus blocks over a static shelf,
+///         checking every step that no particle was lost or duplicated and
+///         that static cells, the guard band included, never moved.
+/// \param  scenario    the particles to simulate.
+/// \param  steps       the number of steps to run.
+/// \return true if particles were conserved and some fell asleep.
+static bool checkMargolusConserved(Scenario scenario, const size_t& steps) {
+    scenario.linkComponents();
+    CollisionFixture fixture;
+    fixture.m_collision.setMode(CollisionSystem::Mode::MARGOLUS);
+    for (int x = 100; x < 400; ++x)
+        fixture.m_staticLayer.add(makeParticle(Material::SAND, x, 120));
+
+    // Remember what each static cell holds, to spot it moving
+    std::vector<std::pair<int, int>> staticCells;
+    std::vector<const ParticleComponent*> staticParticles;
+    for (int y = 0; y <= guardMax; ++y)
+        for (int x = 0; x <= guardMax; ++x)
+            if (fixture.m_staticLayer.test(x, y)) {
+                staticCells.emplace_back(x, y);
+                staticParticles.push_back(fixture.m_particleArray[y][x]);
+            }
+    const size_t expected =
+        scenario.m_particles.size() + fixture.m_staticLayer.size();
+
+    for (size_t step = 0ULL; step < steps; ++step) {
+        fixture.m_rng.setStep(step + 1ULL);
+        fixture.m_collision.updateComponents(0.025, scenario.m_components);
+        const auto after = " after step " + std::to_string(step);
+
+        size_t occupied = 0ULL;
+        for (int y = 0; y <= guardMax; ++y)
+            for (int x = 0; x <= guardMax; ++x)
+                occupied += static_cast<size_t>(
+                    fixture.m_particleArray[y][x] != nullptr);
+        if (!expect(
+                occupied == expected,
+                std::to_string(expected) + " occupied cells" + after))
+            return false;
+        for (size_t index = 0ULL; index < staticCells.size(); ++index) {
+            const auto [x, y] = staticCells[index];
+            if (!expect(
+                    fixture.m_staticLayer.test(x, y) &&
+                        fixture.m_particleArray[y][x] ==
+                            staticParticles[index],
+                    "static cell " + std::to_string(x) + "," +
+                        std::to_string(y) + " in place" + after))
+                return false;
+        }
+        for (const auto& particle : scenario.m_particles) {
+            const int x = static_cast<int>(particle.m_pos.x());
+            const int y = static_cast<int>(particle.m_pos.y());
+            if (!expect(
+                    inPlayArea(x, y) &&
+                        fixture.m_particleArray[y][x] == &particle,
+                    "each particle in the cell it reports" + after))
+                return false;
+        }
+    }
+
+    // Settled blocks fall asleep, so can be promoted to the static layer
+    return expect(
+        std::any_of(
+            scenario.m_particles.begin(), scenario.m_particles.end(),
+            [](const ParticleComponent& particle) {
+                return particle.m_asleep;
+            }),
+        "some particles asleep once settled");
+}
+
+//////////////////////////////////////////////////////////////////////
+/// ReactionSystem::update
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Douse a fire next to unlit oil, checking the fire goes out
+///         before it spreads, while an undoused fire does spread.
+/// \return true if only the undoused fire spread.
+static bool checkExtinguishFirst() {
+    ReactionFixture fixture(3ULL);
+    fixture.build({ { Material::WATER, 100, 100 },
+                    { Material::OIL, 101, 100 },
+                    { Material::OIL, 102, 100 },
+                    { Material::OIL, 201, 100 },
+                    { Material::OIL, 202, 100 } });
+    fixture.ignite(101, 100);
+    fixture.ignite(201, 100);
+    const auto ignition = fixture.at(101, 100).m_ignition;
+    fixture.m_reactions.update(0.025);
+
+    const auto burning = [&](const int& x) {
+        return (fixture.at(x, 100).m_state & ParticleComponent::BURNING) != 0U;
+    };
+    return expect(!burning(101), "the doused fire out") &&
+           expect(
+               fixture.at(101, 100).m_ignition != ignition,
+               "the doused fire's timers stale") &&
+           expect(!burning(102), "the doused fire not to spread") &&
+           expect(burning(202), "the undoused fire to spread");
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Leave acid touching sand and the guard band for a few steps,
+///         checking the sand wears away and the concrete never does.
+/// \return true if only the sand and the acid touching it were damaged.
+static bool checkDissolveSand() {
+    constexpr size_t steps = 4ULL;
+    ReactionFixture fixture(3ULL);
+    fixture.build({ { Material::ACID, playMin, playMin },
+                    { Material::SAND, playMin + 1, playMin },
+                    { Material::ACID, playMin, 100 },
+                    { Material::ACID, playMax, playMax } });
+    const auto sandHealth = fixture.at(playMin + 1, playMin).m_health;
+    const auto acidHealth = fixture.at(playMin, 100).m_health;
+    for (size_t step = 0ULL; step < steps; ++step)
+        fixture.m_reactions.update(0.025);
+
+    bool intact = true;
+    const auto concreteHealth =
+        makePreset(Material::CONCRETE).particle.m_health;
+    for (int y = 0; y <= guardMax; ++y)
+        for (int x = 0; x <= guardMax; ++x)
+            if (!inPlayArea(x, y))
+                intact = intact && fixture.at(x, y).m_health == concreteHealth;
+    return expect(
+               fixture.at(playMin + 1, playMin).m_health < sandHealth,
+               "the sand dissolved") &&
+           expect(
+               fixture.at(playMin, playMin).m_health < acidHealth,
+               "the acid touching sand worn away") &&
+           expect(
+               fixture.at(playMin, 100).m_health == acidHealth &&
+                   fixture.at(playMax, playMax).m_health == acidHealth,
+               "acid touching only concrete left whole") &&
+           expect(intact, "the guard band whole") &&
+           expect(
+               fixture.m_staticLayer.getDemotions().empty(),
+               "no guard band cell returned to the world");
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Run the same reactions on one worker and on three, checking
+///         the bands merge into identical lists and outcomes.
+/// \param  steps   the number of steps to run.
+/// \return true if both runs matched throughout.
+static bool checkReactionBands(const size_t& steps) {
+    // Every reactant scattered over the whole grid, some of it burning
+    constexpr std::array<Material, 5> materials{ Material::WATER,
+                                                 Material::OIL,
+                                                 Material::GASOLINE,
+                                                 Material::ACID,
+                                                 Material::SAND };
+    const CounterRNG rng(7ULL);
+    std::vector<ParticleDescriptor> descriptors;
+    std::vector<std::pair<int, int>> fires;
+    for (int y = playMin; y <= playMax; ++y)
+        for (int x = playMin; x <= playMax; ++x) {
+            if (rng.uniform(x, y, 0U) >= 0.4F)
+                continue;
+            const auto material = materials[std::min(
+                static_cast<size_t>(rng.uniform(x, y, 1U) * 5.0F),
+                materials.size() - 1)];
+            descriptors.push_back({ material, x, y });
+            if ((material == Material::OIL ||
+                 material == Material::GASOLINE) &&
+                rng.uniform(x, y, 2U) < 0.05F)
+                fires.emplace_back(x, y);
+        }
+    ReactionFixture single(1ULL);
+    ReactionFixture several(3ULL);
+    for (auto* fixture : { &single, &several }) {
+        fixture->build(descriptors);
+        for (const auto& [x, y] : fires)
+            fixture->ignite(x, y);
+    }
+
+    // Pairs are compared by the cells they join, the entities differing
+    const auto cellOf = [](ReactionFixture& fixture,
+                           const EntityHandle& handle) {
+        const auto entity = fixture.m_world.getEntity(handle);
+        const auto& particle = *static_cast<ParticleComponent*>(
+            fixture.m_world.getComponent<ParticleComponent>(*entity));
+        return std::make_pair(
+            static_cast<int>(particle.m_pos.x()),
+            static_cast<int>(particle.m_pos.y()));
+    };
+    for (size_t step = 0ULL; step < steps; ++step) {
+        single.m_reactions.update(0.025);
+        several.m_reactions.update(0.025);
+        const auto after = " after step " + std::to_string(step);
+        for (size_t reaction = 0ULL; reaction < reactionCount; ++reaction) {
+            const auto& expected =
+                single.m_reactions.getReactions(Reaction(reaction));
+            const auto& found =
+                several.m_reactions.getReactions(Reaction(reaction));
+            if (!expect(
+                    found.size() == expected.size(),
+                    "as many pairs of reaction " + std::to_string(reaction) +
+                        after))
+                return false;
+            for (size_t index = 0ULL; index < found.size(); ++index)
+                if (cellOf(single, expected[index].source) !=
+                        cellOf(several, found[index].source) ||
+                    cellOf(single, expected[index].target) !=
+                        cellOf(several, found[index].target))
+                    return expect(
+                        false, "pair " + std::to_string(index) +
+                                   " of reaction " + std::to_string(reaction) +
+                                   " to match" + after);
+        }
+        for (const auto& [material, x, y] : descriptors) {
+            const auto& expected = single.at(x, y);
+            const auto& found = several.at(x, y);
+            if (!expect(
+                    found.m_state == expected.m_state &&
+                        found.m_ignition == expected.m_ignition &&
+                        found.m_health == expected.m_health,
+                    "cell " + std::to_string(x) + "," + std::to_string(y) +
+                        " to match" + after))
+                return false;
+        }
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// HeatField::diffuse
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Diffuse a field by the chunked kernel and by the reference side
+///         by side, checking they agree on every cell after every step.
+///         Cells are heated and cooled in the corners, along the edges and
+///         either side of chunk borders, re-applied now and then so chunks
+///         keep falling asleep and waking up.
+/// \param  width   the number of columns.
+/// \param  height  the number of rows.
+/// \param  steps   the number of steps to run.
+/// \return true if both fields matched throughout.
+static bool
+checkHeatField(const int& width, const int& height, const size_t& steps) {
+    constexpr float tolerance = 0.05F;
+    ThreadPool threadPool(3ULL);
+    HeatField field(width, height);
+    HeatField reference(width, height);
+    const auto heat = [&](const int& x, const int& y, const float& amount) {
+        const int cellX = std::clamp(x, 0, width - 1);
+        const int cellY = std::clamp(y, 0, height - 1);
+        field.add(cellX, cellY, amount);
+        reference.add(cellX, cellY, amount);
+    };
+
+    for (size_t step = 0ULL; step < steps; ++step) {
+        if (step % 48ULL == 0ULL) {
+            heat(0, 0, 900.0F);
+            heat(width - 1, height - 1, 600.0F);
+            heat(width - 1, 0, -15.0F);
+            heat(0, height / 2, 300.0F);
+            heat(HeatField::CHUNK - 1, HeatField::CHUNK, 450.0F);
+            heat(HeatField::CHUNK, HeatField::CHUNK - 1, 450.0F);
+            heat(width / 2, height - 1, 250.0F);
+        }
+        field.diffuse(0.025F, threadPool);
+        reference.diffuseReference(0.025F);
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+                if (std::fabs(field.get(x, y) - reference.get(x, y)) >
+                    tolerance)
+                    return expect(
+                        false, "cell " + std::to_string(x) + "," +
+                                   std::to_string(y) +
+                                   " to match the reference after step " +
+                                   std::to_string(step));
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// parseMaterialMap
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Parse a material map, checking it gives the expected particles.
+/// \param  bytes       the image file's contents.
+/// \param  expected    the particles the image describes, in order.
+/// \return true if the image parsed into the expected particles.
+static bool checkMaterialMap(
+    const std::string& bytes,
+    const std::vector<ParticleDescriptor>& expected) {
+    std::string error;
+    const auto parsed = parseMaterialMap(bytes, error);
+    if (!expect(parsed.has_value(), "the image to parse, got: " + error) ||
+        !expect(
+            parsed->size() == expected.size(),
+            std::to_string(expected.size()) + " particles, got " +
+                std::to_string(parsed->size())))
+        return false;
+    for (size_t index = 0ULL; index < expected.size(); ++index) {
+        const auto& got = (*parsed)[index];
+        const auto& want = expected[index];
+        if (!expect(
+                got.material == want.material && got.x == want.x &&
+                    got.y == want.y,
+                "particle " + std::to_string(index) + " at " +
+                    std::to_string(want.x) + "," + std::to_string(want.y)))
+            return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Write the colour of a material as an 8-bit pixel.
+/// \param  material    the material whose colour to write.
+/// \param  binary      true to write raw bytes, false to write text.
+/// \return the pixel's samples.
+static std::string colourOf(const Material& material, const bool& binary) {
+    const auto color = makePreset(material).particle.m_color;
+    std::string pixel;
+    for (const float& channel : { color.x(), color.y(), color.z() }) {
+        const auto sample = std::lround(channel * 255.0F);
+        pixel += binary ? std::string(1, static_cast<char>(sample))
+                        : std::to_string(sample) + " ";
+    }
+    return pixel;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  The particles of the 3x2 test image, top row first.
+/// \return the particles in the play area's top-left corner.
+static std::vector<ParticleDescriptor> makeCornerParticles() {
+    return { { Material::CONCRETE, playMin, playMax },
+             { Material::SAND, playMin + 2, playMax },
+             { Material::WATER, playMin + 1, playMax - 1 },
+             { Material::ACID, playMin + 2, playMax - 1 } };
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Check material maps with text samples parse.
+/// \return true if every image parsed as expected.
+static bool checkPlainMaterialMaps() {
+    const auto colours = "P3\n2 1\n255\n" + colourOf(Material::OIL, false) +
+                         "0 0 0\n";
+    return checkMaterialMap(
+               "P2\n# grey levels name materials\n3 2\n7\n1 0 2\n0 6 7\n",
+               makeCornerParticles()) &&
+           checkMaterialMap(colours, { { Material::OIL, playMin, playMax } });
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Check material maps with raw samples parse, including one wider
+///         than the play area.
+/// \return true if every image parsed as expected.
+static bool checkBinaryMaterialMaps() {
+    const auto colours = "P6 2 1 255\n" + colourOf(Material::ACID, true) +
+                         colourOf(Material::GUNPOWDER, true);
+    constexpr int playSize = playMax - playMin + 1;
+    std::vector<ParticleDescriptor> row;
+    for (int x = playMin; x <= playMax; ++x)
+        row.push_back({ Material::SAND, x, playMax });
+    return checkMaterialMap(
+               std::string("P5 3 2 7\n\1\0\2\0\6\7", 16ULL),
+               makeCornerParticles()) &&
+           checkMaterialMap(
+               colours, { { Material::ACID, playMin, playMax },
+                          { Material::GUNPOWDER, playMin + 1, playMax } }) &&
+           checkMaterialMap(
+               "P5 " + std::to_string(playSize + 40) + " 1 255\n" +
+                   std::string(static_cast<size_t>(playSize + 40), '\2'),
+               row);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Check broken material maps are rejected with an error, without
+///         trusting their dimensions.
+/// \return true if every image was rejected.
+static bool checkInvalidMaterialMaps() {
+    const std::vector<std::string> images = {
+        "",
+        "GIF89a",
+        "P7 1 1 255\n\1",
+        "P5 2",
+        "P5 0 4 255\n",
+        "P5 1 1 65535\n\1\1",
+        "P5 99999999999999999999 1 255\n\1",
+        "P5 1 2147483648 255\n\1",
+        "P5 46341 46341 255\n\1\2\3",
+        "P6 2 2 255\n\1\2\3\4\5\6",
+        "P2 2 1 7\n1",
+        "P2 2 1 7\n1 9",
+        "P2 2 1 255\n1 200",
+    };
+    bool rejected = true;
+    for (const auto& image : images) {
+        std::string error;
+        const bool parsed = parseMaterialMap(image, error).has_value();
+        rejected = expect(
+                       !parsed && !error.empty(),
+                       "\"" + image.substr(0ULL, 24ULL) +
+                           "\" to be rejected with an error") &&
+                   rejected;
+    }
+    return rejected;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// CheckpointWriter / CheckpointReader
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \struct WrittenCheckpoints
+/// \brief  A checkpoint stream and the frames the writer accepted for it.
+struct WrittenCheckpoints {
+    std::string bytes;                             ///< The whole stream.
+    std::vector<std::vector<std::uint8_t>> frames; ///< Accepted frames.
+    std::vector<std::uint64_t> steps;              ///< Their steps.
+    size_t headerSize = 0ULL; ///< Bytes before the first record.
+};
+
+//////////////////////////////////////////////////////////////////////
+/// Checkpoints per full base written by the checks
+constexpr size_t checkBaseInterval = 4ULL;
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Retrieve a scratch file path for a check.
+/// \param  name    the file's name.
+/// \return the path, in the system's temporary directory.
+static std::string scratchPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Read a whole file.
+/// \param  path    the path to the file.
+/// \return the file's contents.
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream bytes;
+    bytes << file.rdbuf();
+    return bytes.str();
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Replace a file's contents.
+/// \param  path    the path to the file.
+/// \param  bytes   the contents to write.
+static void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Fill the frame of an attempted checkpoint: scattered grains, a
+///         block sliding across chunk borders, and every fifth frame left
+///         as the one before it so some deltas carry no chunks.
+/// \param  attempt the checkpoint's attempt number.
+/// \param  frame   the frame to fill, already cleared.
+static void fillFrame(const size_t& attempt, std::vector<std::uint8_t>& frame) {
+    const size_t shown = attempt % 5ULL == 4ULL ? attempt - 1ULL : attempt;
+    constexpr auto side = static_cast<size_t>(CheckpointWriter::SIDE);
+    for (size_t cell = shown % 97ULL; cell < frame.size(); cell += 97ULL)
+        frame[cell] = static_cast<std::uint8_t>(1ULL + cell % 7ULL);
+    const size_t left = (shown * 37ULL) % (side - 40ULL);
+    const size_t top = (shown * 53ULL) % (side - 40ULL);
+    for (size_t y = top; y < top + 40ULL; ++y)
+        for (size_t x = left; x < left + 40ULL; ++x)
+            frame[y * side + x] =
+                static_cast<std::uint8_t>(1ULL + shown % (materialCount - 1));
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Stream checkpoints to a file, waiting on the writer for the
+///         first half and racing it for the rest, so frames get dropped.
+/// \param  attempts    the number of checkpoints to attempt.
+/// \param  written     filled with the stream and its accepted frames.
+/// \return true if the writer accounted for every attempt.
+static bool
+writeCheckpoints(const size_t& attempts, WrittenCheckpoints& written) {
+    const auto path = scratchPath("particules_check.ckpt");
+    std::string error;
+    CheckpointWriter writer;
+    if (!expect(
+            writer.open(path, checkBaseInterval, error),
+            "the stream to open, got: " + error))
+        return false;
+    written.headerSize = writer.getStats().bytes;
+
+    for (size_t attempt = 0ULL; attempt < attempts; ++attempt) {
+        if (attempt < attempts / 2ULL)
+            while (writer.getStats().bases + writer.getStats().deltas <
+                   written.frames.size())
+                std::this_thread::yield();
+        if (!writer.beginCheckpoint())
+            continue;
+        fillFrame(attempt, writer.getFrame());
+        written.frames.push_back(writer.getFrame());
+        written.steps.push_back(attempt * 10ULL + 3ULL);
+        writer.submit(written.steps.back());
+    }
+    writer.close();
+    const auto stats = writer.getStats();
+    written.bytes = readFile(path);
+    std::filesystem::remove(path);
+    return expect(!stats.failed, "the stream to be written") &&
+           expect(
+               stats.bases + stats.deltas == written.frames.size() &&
+                   stats.dropped == attempts - written.frames.size(),
+               "every attempt to be written or dropped") &&
+           expect(
+               stats.bytes == written.bytes.size(),
+               "the file to hold every byte written");
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Load a stream, checking it holds a prefix of the written one:
+///         the first checkpoints, each rebuilding its submitted frame.
+/// \param  bytes   the stream to load.
+/// \param  written the stream written and its accepted frames.
+/// \param  count   the number of checkpoints expected.
+/// \return true if the stream loaded with the expected checkpoints.
+static bool checkCheckpoints(
+    const std::string& bytes, const WrittenCheckpoints& written,
+    const size_t& count) {
+    const auto path = scratchPath("particules_check_load.ckpt");
+    writeFile(path, bytes);
+    std::string error;
+    const auto reader = CheckpointReader::load(path, error);
+    std::filesystem::remove(path);
+    if (!expect(reader.has_value(), "the stream to load, got: " + error) ||
+        !expect(
+            reader->size() == count,
+            std::to_string(count) + " checkpoints, got " +
+                std::to_string(reader->size())))
+        return false;
+    for (size_t index = 0ULL; index < count; ++index) {
+        const auto what = " of checkpoint " + std::to_string(index);
+        if (!expect(
+                reader->getStep(index) == written.steps[index] &&
+                    reader->isBase(index) ==
+                        (index % checkBaseInterval == 0ULL),
+                "the step and kind" + what) ||
+            !expect(
+                reader->reconstruct(index) == written.frames[index],
+                "the submitted frame to be rebuilt" + what))
+            return false;
+    }
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Check every accepted checkpoint reads back as submitted, and
+///         describes its occupied cells.
+/// \return true if the stream round-tripped.
+static bool checkCheckpointRoundTrip() {
+    WrittenCheckpoints written;
+    if (!writeCheckpoints(40ULL, written) ||
+        !checkCheckpoints(written.bytes, written, written.frames.size()))
+        return false;
+
+    const auto path = scratchPath("particules_check_describe.ckpt");
+    writeFile(path, written.bytes);
+    std::string error;
+    const auto reader = CheckpointReader::load(path, error);
+    std::filesystem::remove(path);
+    const auto last = written.frames.size() - 1ULL;
+    const auto& frame = written.frames[last];
+    const auto descriptors = reader->describe(last);
+    size_t occupied = 0ULL;
+    for (const auto& [material, x, y] : descriptors) {
+        const auto cell = static_cast<size_t>(
+            y * CheckpointWriter::SIDE + x);
+        if (!expect(
+                static_cast<std::uint8_t>(material) == frame[cell] &&
+                    frame[cell] != 0U,
+                "cell " + std::to_string(x) + "," + std::to_string(y) +
+                    " to be described by its material"))
+            return false;
+    }
+    for (const auto& cell : frame)
+        occupied += cell != 0U ? 1ULL : 0ULL;
+    return expect(
+        descriptors.size() == occupied, "every occupied cell described");
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Check a stream cut short keeps every whole checkpoint before
+///         the cut.
+/// \return true if every truncated stream loaded its whole checkpoints.
+static bool checkCheckpointTruncated() {
+    WrittenCheckpoints written;
+    if (!writeCheckpoints(12ULL, written))
+        return false;
+    const auto count = written.frames.size();
+    const auto& bytes = written.bytes;
+    if (!checkCheckpoints(bytes.substr(0ULL, bytes.size() - 1ULL), written,
+                          count - 1ULL) ||
+        !checkCheckpoints(
+            bytes.substr(0ULL, written.headerSize + 7ULL), written, 0ULL) ||
+        !checkCheckpoints(
+            bytes.substr(0ULL, written.headerSize), written, 0ULL))
+        return false;
+
+    // Cutting anywhere leaves a prefix of the checkpoints
+    size_t previous = 0ULL;
+    for (size_t cut = written.headerSize; cut <= bytes.size(); cut += 977ULL) {
+        const auto path = scratchPath("particules_check_cut.ckpt");
+        writeFile(path, bytes.substr(0ULL, cut));
+        std::string error;
+        const auto reader = CheckpointReader::load(path, error);
+        std::filesystem::remove(path);
+        if (!expect(
+                reader.has_value(), "a cut stream to load, got: " + error) ||
+            !expect(
+                reader->size() >= previous,
+                "longer cuts to keep at least as many checkpoints"))
+            return false;
+        previous = reader->size();
+        if (!checkCheckpoints(bytes.substr(0ULL, cut), written, previous))
+            return false;
+    }
+
+    std::string error;
+    const auto path = scratchPath("particules_check_header.ckpt");
+    writeFile(path, bytes.substr(0ULL, written.headerSize - 1ULL));
+    const bool loaded = CheckpointReader::load(path, error).has_value();
+    std::filesystem::remove(path);
+    return expect(!loaded && !error.empty(), "a cut header to be rejected");
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Check streams with a corrupted record are rejected.
+/// \return true if every corrupted stream was rejected with an error.
+static bool checkCheckpointCorrupt() {
+    WrittenCheckpoints written;
+    if (!writeCheckpoints(6ULL, written))
+        return false;
+    // Offsets into the first record, per the layout in checkpoint.cpp: a
+    // 15 byte record header, then each chunk's 4 byte header and its runs
+    const auto record = written.headerSize;
+    const auto chunk = record + 15ULL;
+    const auto runs = chunk + 4ULL;
+    const std::vector<std::pair<size_t, char>> corruptions = {
+        { record, '\x07' },          // Unknown record kind
+        { record, '\x01' },          // Stream opening with a delta
+        { record + 9ULL, '\x05' },   // Base missing chunks
+        { record + 11ULL, '\x00' },  // Record length off
+        { chunk + 1ULL, '\x7F' },    // Chunk out of range
+        { chunk + 2ULL, '\x01' },    // Odd run bytes
+        { runs, '\x00' },            // Empty run
+        { runs + 1ULL, '\x7F' },     // Unknown material
+    };
+    bool rejected = true;
+    for (const auto& [offset, value] : corruptions) {
+        auto bytes = written.bytes;
+        bytes[offset] = value;
+        const auto path = scratchPath("particules_check_corrupt.ckpt");
+        writeFile(path, bytes);
+        std::string error;
+        const bool loaded = CheckpointReader::load(path, error).has_value();
+        std::filesystem::remove(path);
+        rejected = expect(
+                       !loaded && !error.empty(),
+                       "corrupting byte " + std::to_string(offset) +
+                           " to be rejected") &&
+                   rejected;
+    }
+    return rejected;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// TripleBuffer
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Check the reader only sees whole, published buffers, newest
+///         first: once on its own thread, then against a writer racing it.
+/// \return true if every consumed buffer was whole and no older than the
+///         one before it.
+static bool checkSnapshotHandoff() {
+    using Snapshot = std::array<std::uint32_t, 1024>;
+    TripleBuffer<Snapshot> buffers;
+    const auto write = [&](const std::uint32_t& value) {
+        buffers.getWriteBuffer().fill(value);
+        buffers.publish();
+    };
+    const auto whole = [&](const std::uint32_t& value) {
+        const auto& snapshot = buffers.getReadBuffer();
+        return std::all_of(
+            snapshot.cbegin(), snapshot.cend(),
+            [&](const std::uint32_t& cell) { return cell == value; });
+    };
+
+    // Nothing is consumed until published, then only the newest buffer
+    if (!expect(!buffers.consume(), "nothing to consume before publishing"))
+        return false;
+    write(1U);
+    write(2U);
+    if (!expect(buffers.consume() && whole(2U), "the newest buffer") ||
+        !expect(!buffers.consume() && whole(2U), "it to stay consumed"))
+        return false;
+
+    // A writer racing the reader never hands over a torn or older buffer
+    constexpr std::uint32_t published = 20000U;
+    std::thread writer([&] {
+        for (std::uint32_t value = 3U; value <= published; ++value)
+            write(value);
+    });
+    std::uint32_t last = 2U;
+    bool ordered = true;
+    while (ordered && last != published) {
+        if (!buffers.consume())
+            continue;
+        const auto value = buffers.getReadBuffer().front();
+        ordered = expect(whole(value), "buffer " + std::to_string(value) +
+                                           " to be consumed whole") &&
+                  expect(value > last, "buffer " + std::to_string(value) +
+                                           " to be newer than " +
+                                           std::to_string(last));
+        last = value;
+    }
+    writer.join();
+    return ordered;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// SystemScheduler
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Check tasks are ordered exactly where their data conflicts,
+///         directly or through other tasks, and that every run keeps to
+///         that order.
+/// \return true if the graph held the expected orderings and no others.
+static bool checkSchedulerGraph() {
+    using Resource = SystemScheduler::Resource;
+    ThreadPool threadPool(3ULL);
+    Profiler profiler;
+    SystemScheduler scheduler(threadPool, profiler);
+    std::array<std::atomic<size_t>, 6> runs{};
+    std::atomic<bool> inOrder{ true };
+    const auto task = [&](const size_t& index, std::vector<size_t> after) {
+        return [&, index, after] {
+            // Every task it waits on already ran this round
+            for (const auto& parent : after)
+                if (runs[parent] <= runs[index])
+                    inOrder = false;
+            ++runs[index];
+        };
+    };
+    scheduler.addTask("Particles", 0U, Resource::PARTICLES, task(0, {}));
+    scheduler.addTask(
+        "Grid", Resource::PARTICLES, Resource::GRID, task(1, { 0 }));
+    scheduler.addTask("Heat", 0U, Resource::HEAT, task(2, {}));
+    scheduler.addTask(
+        "Grid Reader", Resource::GRID | Resource::HEAT, 0U,
+        task(3, { 1, 2 }));
+    scheduler.addTask("Spawner", Resource::SPAWNERS, 0U, task(4, {}));
+    scheduler.addTask(
+        "Particles Again", 0U, Resource::PARTICLES, task(5, { 0, 1 }));
+
+    const std::vector<std::pair<std::string, std::string>> ordered = {
+        { "Particles", "Grid" },
+        { "Grid", "Grid Reader" },
+        { "Heat", "Grid Reader" },
+        { "Particles", "Grid Reader" },
+        { "Particles", "Particles Again" },
+        { "Grid", "Particles Again" },
+    };
+    const std::vector<std::pair<std::string, std::string>> unordered = {
+        { "Particles", "Heat" },
+        { "Heat", "Particles Again" },
+        { "Grid Reader", "Particles Again" },
+        { "Particles", "Spawner" },
+        { "Spawner", "Particles Again" },
+        { "Grid", "Heat" },
+    };
+    bool held = true;
+    for (const auto& [first, second] : ordered)
+        held = expect(
+                   scheduler.isOrdered(first, second),
+                   second + " to wait on " + first) &&
+               held;
+    for (const auto& [first, second] : unordered)
+        held = expect(
+                   !scheduler.isOrdered(first, second),
+                   second + " to run alongside " + first) &&
+               held;
+
+    for (size_t round = 0ULL; round < 50ULL; ++round)
+        scheduler.run();
+    return held && expect(inOrder, "every run to keep to the graph") &&
+           expect(
+               std::all_of(
+                   runs.cbegin(), runs.cend(),
+                   [](const std::atomic<size_t>& count) {
+                       return count == 50ULL;
+                   }),
+               "every task to run once per run");
+}
+
+//////////////////////////////////////////////////////////////////////
+/// TimerWheel
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Check timers fire exactly once, on the step they're due, from
+///         every level of the wheel. Timers are set either side of fine
+///         and coarse revolutions, including from within the last
+///         revolution before the coarse wheel wraps.
+/// \return true if every timer fired once, on time.
+static bool checkTimerCascade() {
+    constexpr auto slots = TimerWheel<size_t>::SLOTS;
+    TimerWheel<size_t> wheel;
+    std::vector<size_t> due;
+    std::vector<size_t> fired;
+    bool onTime = true;
+    const auto scheduleAround = [&](const std::vector<size_t>& delays) {
+        for (const auto& delay : delays)
+            for (size_t offset = 0ULL; offset < 3ULL; ++offset) {
+                wheel.schedule(due.size(), delay + offset - 1ULL);
+                due.push_back(
+                    wheel.step() + std::max<size_t>(delay + offset - 1ULL, 1));
+                fired.push_back(0ULL);
+            }
+    };
+    const auto advance = [&] {
+        wheel.advance([&](const size_t& timer) {
+            ++fired[timer];
+            onTime = expect(
+                         wheel.step() == due[timer],
+                         "timer " + std::to_string(timer) +
+                             " to fire on step " + std::to_string(due[timer]) +
+                             ", not " + std::to_string(wheel.step())) &&
+                     onTime;
+        });
+    };
+
+    // Start part way into a revolution, so nothing lines up with slot 0
+    for (size_t step = 0ULL; step < 200ULL; ++step)
+        advance();
+    scheduleAround(
+        { 1ULL, 56ULL, slots, slots + 56ULL, slots * 7ULL,
+          slots * slots - 200ULL, slots * slots, slots * slots * 2ULL,
+          slots * slots * 3ULL + 99ULL });
+
+    // Set more from just before the coarse wheel wraps
+    const size_t last = due.back() + slots;
+    while (wheel.step() < last) {
+        if (wheel.step() + 3ULL == slots * slots)
+            scheduleAround({ 1ULL, 3ULL, 4ULL, slots, slots * 2ULL });
+        advance();
+    }
+
+    for (size_t timer = 0ULL; timer < fired.size(); ++timer)
+        onTime = expect(
+                     fired[timer] == 1ULL,
+                     "timer " + std::to_string(timer) +
+                         " to fire once, it fired " +
+                         std::to_string(fired[timer]) + " times") &&
+                 onTime;
+    return onTime && expect(wheel.size() == 0ULL, "no timer left pending");
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Light and douse a particle over and over, its ignition count
+///         wrapping past 255, and check only the last ignition's timer is
+///         current when the timers expire, some before it and some after.
+/// \return true if exactly the last ignition's timer was current.
+static bool checkStaleTimers() {
+    TimerWheel<FireTimer> wheel;
+    ParticleComponent particle;
+    particle.m_ignition = 250U;
+    size_t lastDue = 0ULL;
+    for (size_t ignition = 0ULL; ignition < 12ULL; ++ignition) {
+        if (ignition != 0ULL)
+            ++particle.m_ignition;
+        const size_t delay = 30ULL + (ignition * 7ULL) % 13ULL;
+        wheel.schedule(FireTimer{ {}, particle.m_ignition }, delay);
+        lastDue = wheel.step() + delay;
+        wheel.advance([](const FireTimer&) {});
+    }
+
+    std::vector<size_t> current;
+    while (wheel.size() != 0ULL)
+        wheel.advance([&](const FireTimer& timer) {
+            if (timer.isCurrent(particle))
+                current.push_back(wheel.step());
+        });
+    return expect(particle.m_ignition == 5U, "the ignition count to wrap") &&
+           expect(
+               current == std::vector<size_t>{ lastDue },
+               "only the last ignition's timer, due on step " +
+                   std::to_string(lastDue) + ", to be current");
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Retrieve every check.
+/// \return the checks.
+static std::vector<CheckCase> makeCases() {
+    return {
+        { "settled_falling",
+          [] {
+              return checkSettledCells(
+                  makeFallingScenario(131072ULL, 1.0F), 300ULL);
+          } },
+        { "settled_mixed",
+          [] {
+              return checkSettledCells(
+                  makeMixedScenario(65536ULL, 0.75F, 2ULL), 300ULL);
+          } },
+        { "margolus_conserved",
+          [] {
+              return checkMargolusConserved(
+                  makeMixedScenario(65536ULL, 0.75F, 3ULL), 300ULL);
+          } },
+        { "heat_square", [] { return checkHeatField(513, 513, 200ULL); } },
+        { "heat_odd",
+          [] {
+              // Widths and heights off the SIMD and chunk multiples, down to
+              // a single partial chunk
+              return checkHeatField(67, 131, 200ULL) &&
+                     checkHeatField(130, 3, 200ULL) &&
+                     checkHeatField(5, 70, 200ULL) &&
+                     checkHeatField(1, 1, 50ULL);
+          } },
+        { "reaction_extinguish", checkExtinguishFirst },
+        { "reaction_dissolve", checkDissolveSand },
+        { "reaction_bands", [] { return checkReactionBands(6ULL); } },
+        { "loader_plain", checkPlainMaterialMaps },
+        { "loader_binary", checkBinaryMaterialMaps },
+        { "loader_invalid", checkInvalidMaterialMaps },
+        { "checkpoint_roundtrip", checkCheckpointRoundTrip },
+        { "checkpoint_truncated", checkCheckpointTruncated },
+        { "checkpoint_corrupt", checkCheckpointCorrupt },
+        { "snapshot_handoff", checkSnapshotHandoff },
+        { "scheduler_graph", checkSchedulerGraph },
+        { "timer_cascade", checkTimerCascade },
+        { "timer_stale", checkStaleTimers },
+    };
+}
+
+//////////////////////////////////////////////////////////////////////
+/// main
+//////////////////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[]) {
+    // Usage: particules_checks [--case name]
+    std::string onlyCase;
+    for (int index = 1; index < argc; ++index) {
+        const std::string argument(argv[index]);
+        if (argument == "--case" && index + 1 < argc)
+            onlyCase = argv[++index];
+        else {
+            std::printf("unknown argument %s\n", argument.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    bool passed = true;
+    bool found = false;
+    for (const auto& check : makeCases()) {
+        if (!onlyCase.empty() && check.name != onlyCase)
+            continue;
+        found = true;
+        const bool held = check.run();
+        std::printf("%s: %s\n", check.name.c_str(), held ? "ok" : "FAIL");
+        passed = held && passed;
+    }
+    if (!found) {
+        std::printf("no case named %s\n", onlyCase.c_str());
+        return EXIT_FAILURE;
+    }
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
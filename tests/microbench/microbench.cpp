@@ -0,0 +1,447 @@
+#include "checkpoint.hpp"
+#include "collision.hpp"
+#include "collisionSystem.hpp"
+#include "componentView.hpp"
+#include "counterRNG.hpp"
+#include "heatField.hpp"
+#include "quadTree.hpp"
+#include "renderSystem.hpp"
+#include "scenario.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+/// Number of pre-generated inputs cycled through by the primitive tests
+constexpr size_t inputCount = 1024ULL;
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Generate points spread over the grid.
+/// \param  stream  the random stream to draw from.
+/// \return the generated points.
+static std::vector<vec2> makePoints(const std::uint32_t& stream) {
+    const CounterRNG rng(7ULL);
+    std::vector<vec2> points;
+    points.reserve(inputCount);
+    for (size_t index = 0; index < inputCount; ++index) {
+        const auto i = static_cast<int>(index);
+        points.emplace_back(
+            rng.uniform(i, 0, stream) * 512.0F,
+            rng.uniform(i, 1, stream) * 512.0F);
+    }
+    return points;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// areColliding_SphereVsBox
+//////////////////////////////////////////////////////////////////////
+
+static void BM_SphereVsBox(benchmark::State& state) {
+    const auto spheres = makePoints(0U);
+    const auto boxes = makePoints(1U);
+    size_t index = 0ULL;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(areColliding_SphereVsBox(
+            spheres[index], 4.0F, boxes[index], vec2(8.0F)));
+        index = (index + 1ULL) % inputCount;
+    }
+}
+BENCHMARK(BM_SphereVsBox);
+
+//////////////////////////////////////////////////////////////////////
+/// areColliding_BoxVsBox
+//////////////////////////////////////////////////////////////////////
+
+static void BM_BoxVsBox(benchmark::State& state) {
+    const auto boxesA = makePoints(0U);
+    const auto boxesB = makePoints(1U);
+    size_t index = 0ULL;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(areColliding_BoxVsBox(
+            boxesA[index], vec2(4.0F), boxesB[index], vec2(8.0F)));
+        index = (index + 1ULL) % inputCount;
+    }
+}
+BENCHMARK(BM_BoxVsBox);
+
+//////////////////////////////////////////////////////////////////////
+/// rayBBoxIntersection
+//////////////////////////////////////////////////////////////////////
+
+static void BM_RayBBox(benchmark::State& state) {
+    const auto origins = makePoints(0U);
+    const auto boxes = makePoints(1U);
+    size_t index = 0ULL;
+    for (auto _ : state) {
+        const auto direction =
+            (boxes[index] - origins[index] + vec2(0.5F)).normalize();
+        benchmark::DoNotOptimize(rayBBoxIntersection(
+            origins[index], direction, boxes[index], vec2(8.0F)));
+        index = (index + 1ULL) % inputCount;
+    }
+}
+BENCHMARK(BM_RayBBox);
+
+//////////////////////////////////////////////////////////////////////
+/// QuadTree::insert
+//////////////////////////////////////////////////////////////////////
+
+static void BM_QuadTreeInsert(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto scenario = makeFallingScenario(count, 1.0F);
+    for (auto _ : state) {
+        QuadTree<const ParticleComponent*> tree(vec2(256.0F), vec2(256.0F));
+        for (const auto& particle : scenario.m_particles)
+            tree.insert(&particle, particle.m_pos, vec2(0.5F));
+        benchmark::DoNotOptimize(&tree);
+    }
+    state.SetItemsProcessed(
+        state.iterations() *
+        static_cast<int64_t>(scenario.m_particles.size()));
+}
+BENCHMARK(BM_QuadTreeInsert)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+
+//////////////////////////////////////////////////////////////////////
+/// QuadTree::search
+//////////////////////////////////////////////////////////////////////
+
+static void BM_QuadTreeSearchBox(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto scenario = makeFallingScenario(count, 1.0F);
+    QuadTree<const ParticleComponent*> tree(vec2(256.0F), vec2(256.0F));
+    for (const auto& particle : scenario.m_particles)
+        tree.insert(&particle, particle.m_pos, vec2(0.5F));
+
+    const auto centers = makePoints(0U);
+    size_t index = 0ULL;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.search(centers[index], vec2(4.0F)));
+        index = (index + 1ULL) % inputCount;
+    }
+}
+BENCHMARK(BM_QuadTreeSearchBox)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+
+static void BM_QuadTreeSearchRadius(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto scenario = makeFallingScenario(count, 1.0F);
+    QuadTree<const ParticleComponent*> tree(vec2(256.0F), vec2(256.0F));
+    for (const auto& particle : scenario.m_particles)
+        tree.insert(&particle, particle.m_pos, vec2(0.5F));
+
+    const auto centers = makePoints(0U);
+    size_t index = 0ULL;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.search(centers[index], 4.0F));
+        index = (index + 1ULL) % inputCount;
+    }
+}
+BENCHMARK(BM_QuadTreeSearchRadius)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 16);
+
+//////////////////////////////////////////////////////////////////////
+/// CollisionSystem
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Time single steps, each from the same canned grid.
+/// \param  state   the benchmark's state.
+/// \param  canned  the particles every step starts from.
+/// \param  mode    the rule set moving particles.
+static void collisionSteps(
+    benchmark::State& state, const Scenario& canned,
+    const CollisionSystem::Mode& mode) {
+    auto scenario = canned;
+    scenario.linkComponents();
+
+    CollisionFixture fixture;
+    fixture.m_collision.setMode(mode);
+    std::uint64_t step = 0ULL;
+    for (auto _ : state) {
+        // Restart from the canned grid, so every step has the same work
+        state.PauseTiming();
+        std::copy(
+            canned.m_particles.cbegin(), canned.m_particles.cend(),
+            scenario.m_particles.begin());
+        fixture.m_rng.setStep(++step);
+        state.ResumeTiming();
+
+        fixture.m_collision.updateComponents(0.025, scenario.m_components);
+    }
+    state.SetItemsProcessed(
+        state.iterations() *
+        static_cast<int64_t>(scenario.m_particles.size()));
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Time steps of a grid left to come to rest first.
+/// \param  state       the benchmark's state.
+/// \param  scenario    the particles to settle.
+/// \param  mode        the rule set moving particles.
+static void settledSteps(
+    benchmark::State& state, Scenario& scenario,
+    const CollisionSystem::Mode& mode) {
+    // Let the particles come to rest before timing
+    CollisionFixture fixture;
+    fixture.m_collision.setMode(mode);
+    std::uint64_t step = 0ULL;
+    for (; step < 600ULL; ++step) {
+        fixture.m_rng.setStep(step);
+        fixture.m_collision.updateComponents(0.025, scenario.m_components);
+    }
+    for (auto _ : state) {
+        fixture.m_rng.setStep(++step);
+        fixture.m_collision.updateComponents(0.025, scenario.m_components);
+    }
+    state.SetItemsProcessed(
+        state.iterations() *
+        static_cast<int64_t>(scenario.m_particles.size()));
+}
+
+static void BM_CollisionStep(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto fillRatio = static_cast<float>(state.range(1)) / 100.0F;
+    const auto mode = static_cast<CollisionSystem::Mode>(state.range(2));
+    collisionSteps(state, makeFallingScenario(count, fillRatio), mode);
+}
+BENCHMARK(BM_CollisionStep)
+    ->ArgNames({ "count", "fill%", "margolus" })
+    ->ArgsProduct({ { 1 << 12, 1 << 15, 1 << 17 },
+                    { 25, 50, 100 },
+                    { static_cast<int>(CollisionSystem::Mode::CELLULAR),
+                      static_cast<int>(CollisionSystem::Mode::MARGOLUS) } })
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_CollisionSettled(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto mode = static_cast<CollisionSystem::Mode>(state.range(1));
+    auto scenario = makeFallingScenario(count, 1.0F);
+    settledSteps(state, scenario, mode);
+}
+BENCHMARK(BM_CollisionSettled)
+    ->ArgNames({ "count", "margolus" })
+    ->ArgsProduct({ { 1 << 12, 1 << 15, 1 << 17 },
+                    { static_cast<int>(CollisionSystem::Mode::CELLULAR),
+                      static_cast<int>(CollisionSystem::Mode::MARGOLUS) } })
+    ->Unit(benchmark::kMicrosecond);
+
+// The engine's even mix of powders and liquids, each behaviour's kernel
+// taking a share of the cells
+static void BM_CollisionMixed(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto fillRatio = static_cast<float>(state.range(1)) / 100.0F;
+    const auto mode = static_cast<CollisionSystem::Mode>(state.range(2));
+    collisionSteps(state, makeMixedScenario(count, fillRatio), mode);
+}
+BENCHMARK(BM_CollisionMixed)
+    ->ArgNames({ "count", "fill%", "margolus" })
+    ->ArgsProduct({ { 1 << 15, 1 << 17 },
+                    { 50, 100 },
+                    { static_cast<int>(CollisionSystem::Mode::CELLULAR),
+                      static_cast<int>(CollisionSystem::Mode::MARGOLUS) } })
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_CollisionMixedSettled(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto mode = static_cast<CollisionSystem::Mode>(state.range(1));
+    auto scenario = makeMixedScenario(count, 1.0F);
+    settledSteps(state, scenario, mode);
+}
+BENCHMARK(BM_CollisionMixedSettled)
+    ->ArgNames({ "count", "margolus" })
+    ->ArgsProduct({ { 1 << 15, 1 << 17 },
+                    { static_cast<int>(CollisionSystem::Mode::CELLULAR),
+                      static_cast<int>(CollisionSystem::Mode::MARGOLUS) } })
+    ->Unit(benchmark::kMicrosecond);
+
+//////////////////////////////////////////////////////////////////////
+/// RenderSystem::packParticles
+//////////////////////////////////////////////////////////////////////
+
+static void BM_PackParticles(benchmark::State& state) {
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto fillRatio = static_cast<float>(state.range(1)) / 100.0F;
+    const auto scenario = makeFallingScenario(count, fillRatio);
+    std::vector<GPU_Particle> particles;
+    for (auto _ : state) {
+        RenderSystem::packParticles(scenario.m_components, particles);
+        benchmark::DoNotOptimize(particles.data());
+    }
+    state.SetItemsProcessed(
+        state.iterations() *
+        static_cast<int64_t>(scenario.m_particles.size()));
+}
+BENCHMARK(BM_PackParticles)
+    ->ArgNames({ "count", "fill%" })
+    ->ArgsProduct({ { 1 << 12, 1 << 15, 1 << 17 }, { 25, 100 } });
+
+//////////////////////////////////////////////////////////////////////
+/// ComponentView
+//////////////////////////////////////////////////////////////////////
+
+// A required and an optional component per entity, as the render system
+// takes them, walked through the view and by indexing the lists directly
+static void BM_ComponentView(benchmark::State& state) {
+    const auto scenario =
+        makeFallingScenario(static_cast<size_t>(state.range(0)), 1.0F);
+    for (auto _ : state) {
+        float health = 0.0F;
+        for (const auto [particleComponent, onFireComponent] :
+             ComponentView<ParticleComponent, OnFireComponent*>(
+                 scenario.m_components))
+            if (onFireComponent == nullptr)
+                health += particleComponent.m_health;
+        benchmark::DoNotOptimize(health);
+    }
+    state.SetItemsProcessed(
+        state.iterations() *
+        static_cast<int64_t>(scenario.m_components.size()));
+}
+BENCHMARK(BM_ComponentView)->ArgName("count")->Arg(1 << 15)->Arg(1 << 17);
+
+static void BM_ComponentViewRaw(benchmark::State& state) {
+    const auto scenario =
+        makeFallingScenario(static_cast<size_t>(state.range(0)), 1.0F);
+    for (auto _ : state) {
+        float health = 0.0F;
+        for (const auto& components : scenario.m_components) {
+            const auto& particleComponent =
+                *static_cast<ParticleComponent*>(components[0]);
+            const auto onFireComponent =
+                static_cast<OnFireComponent*>(components[1]);
+            if (onFireComponent == nullptr)
+                health += particleComponent.m_health;
+        }
+        benchmark::DoNotOptimize(health);
+    }
+    state.SetItemsProcessed(
+        state.iterations() *
+        static_cast<int64_t>(scenario.m_components.size()));
+}
+BENCHMARK(BM_ComponentViewRaw)->ArgName("count")->Arg(1 << 15)->Arg(1 << 17);
+
+//////////////////////////////////////////////////////////////////////
+/// HeatField::diffuse
+//////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Heat a field's cells, on a grid spaced so roughly the given
+///         share of its chunks start out active.
+/// \param  field           the field to heat.
+/// \param  activePercent   the share of chunks to heat.
+static void heatChunks(HeatField& field, const int& activePercent) {
+    constexpr int half = HeatField::CHUNK / 2;
+    const CounterRNG rng(3ULL);
+    const auto share = static_cast<float>(activePercent) / 100.0F;
+    for (int y = half; y < field.getHeight(); y += HeatField::CHUNK)
+        for (int x = half; x < field.getWidth(); x += HeatField::CHUNK)
+            if (rng.uniform(x, y, 0U) < share)
+                field.raise(x, y, 800.0F);
+}
+
+static void BM_HeatDiffuse(benchmark::State& state) {
+    const auto size = static_cast<int>(state.range(0));
+    const auto activePercent = static_cast<int>(state.range(1));
+    ThreadPool threadPool;
+
+    // Check the chunked kernel against the reference before timing it
+    HeatField field(size, size);
+    HeatField reference(size, size);
+    heatChunks(field, activePercent);
+    heatChunks(reference, activePercent);
+    for (int step = 0; step < 32; ++step) {
+        field.diffuse(0.025F, threadPool);
+        reference.diffuseReference(0.025F);
+    }
+    for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x)
+            if (std::fabs(field.get(x, y) - reference.get(x, y)) > 0.1F) {
+                state.SkipWithError("diffusion differs from the reference");
+                return;
+            }
+
+    for (auto _ : state) {
+        // Re-heat outside the timing, so the active chunks stay the same
+        state.PauseTiming();
+        heatChunks(field, activePercent);
+        state.ResumeTiming();
+
+        field.diffuse(0.025F, threadPool);
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<int64_t>(size) *
+        static_cast<int64_t>(size));
+}
+BENCHMARK(BM_HeatDiffuse)
+    ->ArgNames({ "size", "active%" })
+    ->ArgsProduct({ { 513, 2048 }, { 5, 25, 100 } })
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_HeatDiffuseReference(benchmark::State& state) {
+    const auto size = static_cast<int>(state.range(0));
+    HeatField field(size, size);
+    heatChunks(field, 100);
+    for (auto _ : state)
+        field.diffuseReference(0.025F);
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<int64_t>(size) *
+        static_cast<int64_t>(size));
+}
+BENCHMARK(BM_HeatDiffuseReference)
+    ->ArgName("size")
+    ->Arg(513)
+    ->Arg(2048)
+    ->Unit(benchmark::kMicrosecond);
+
+//////////////////////////////////////////////////////////////////////
+/// CheckpointWriter::encodeChunks
+//////////////////////////////////////////////////////////////////////
+
+static void BM_CheckpointEncode(benchmark::State& state) {
+    const auto changedPercent = static_cast<int>(state.range(0));
+    const bool base = state.range(1) != 0;
+
+    // A frame of the mixed scenario, then one cell moved in a share of chunks
+    constexpr int side = CheckpointWriter::SIDE;
+    const auto scenario = makeMixedScenario(1 << 17, 1.0F);
+    std::vector<std::uint8_t> previous(static_cast<size_t>(side) * side, 0U);
+    for (const auto& particle : scenario.m_particles)
+        previous[static_cast<size_t>(
+            static_cast<int>(particle.m_pos.y()) * side +
+            static_cast<int>(particle.m_pos.x()))] =
+            static_cast<std::uint8_t>(particle.m_material);
+    auto current = previous;
+    const CounterRNG rng(5ULL);
+    const auto share = static_cast<float>(changedPercent) / 100.0F;
+    constexpr int chunkCount =
+        CheckpointWriter::CHUNKS * CheckpointWriter::CHUNKS;
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+        if (rng.uniform(chunk, 0, 0U) < share) {
+            const int x = (chunk % CheckpointWriter::CHUNKS) *
+                          CheckpointWriter::CHUNK;
+            const int y = (chunk / CheckpointWriter::CHUNKS) *
+                          CheckpointWriter::CHUNK;
+            current[static_cast<size_t>(y * side + x)] ^= 1U;
+        }
+
+    std::vector<std::uint8_t> out;
+    size_t chunks = 0ULL;
+    for (auto _ : state) {
+        out.clear();
+        chunks = CheckpointWriter::encodeChunks(previous, current, base, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["chunks"] = static_cast<double>(chunks);
+    state.counters["bytes"] = static_cast<double>(out.size());
+    state.SetBytesProcessed(
+        state.iterations() * static_cast<int64_t>(current.size()));
+}
+BENCHMARK(BM_CheckpointEncode)
+    ->ArgNames({ "changed%", "base" })
+    ->Args({ 0, 0 })
+    ->Args({ 10, 0 })
+    ->Args({ 100, 0 })
+    ->Args({ 0, 1 })
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
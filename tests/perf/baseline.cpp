@@ -0,0 +1,176 @@
+#include "baseline.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+//////////////////////////////////////////////////////////////////////
+/// \class  BaselineParser
+/// \brief  Parses the two levels of objects a baseline file is made of.
+class BaselineParser {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a parser over some JSON text.
+    /// \param  text    the text to parse.
+    explicit BaselineParser(const std::string& text) : m_text(text) {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse the whole text.
+    /// \param  error   set to a description of the problem on failure.
+    /// \return the baseline, or nothing on failure.
+    std::optional<Baseline> parse(std::string& error) {
+        Baseline baseline;
+        const bool success = parseObject([&](const std::string& name) {
+            auto& entry = baseline[name];
+            return parseObject([&](const std::string& field) {
+                double value = 0.0;
+                if (!parseNumber(value))
+                    return fail("expected a number for " + name + "." + field);
+                if (field == "stepMicroseconds")
+                    entry.stepMicroseconds = value;
+                else if (field == "timeTolerance")
+                    entry.timeTolerance = value;
+                else if (field == "allocationsPerStep")
+                    entry.allocationsPerStep = value;
+                else if (field == "allocationTolerance")
+                    entry.allocationTolerance = value;
+                else
+                    return fail("unknown field " + name + "." + field);
+                return true;
+            });
+        });
+        skipSpace();
+        if (success && m_pos != m_text.size())
+            fail("unexpected text after the baseline");
+        if (!m_error.empty()) {
+            error = m_error;
+            return {};
+        }
+        return baseline;
+    }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse an object, handing each key to a function that parses
+    ///         its value.
+    /// \param  parseValue  function taking a key, returning false on failure.
+    /// \return true on success, false otherwise.
+    template <typename Func> bool parseObject(Func&& parseValue) {
+        if (!consume('{'))
+            return fail("expected '{'");
+        if (consume('}'))
+            return true;
+        do {
+            std::string key;
+            if (!parseString(key) || !consume(':'))
+                return fail("expected \"key\":");
+            if (!parseValue(key))
+                return false;
+        } while (consume(','));
+        return consume('}') || fail("expected '}' or ','");
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse a string without escape sequences.
+    /// \param  string  set to the string's contents.
+    /// \return true on success, false otherwise.
+    bool parseString(std::string& string) {
+        if (!consume('"'))
+            return false;
+        const auto end = m_text.find('"', m_pos);
+        if (end == std::string::npos)
+            return false;
+        string = m_text.substr(m_pos, end - m_pos);
+        m_pos = end + 1ULL;
+        return true;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Parse a number.
+    /// \param  value   set to the number.
+    /// \return true on success, false otherwise.
+    bool parseNumber(double& value) {
+        skipSpace();
+        const char* begin = m_text.c_str() + m_pos;
+        char* end = nullptr;
+        value = std::strtod(begin, &end);
+        if (end == begin)
+            return false;
+        m_pos += static_cast<size_t>(end - begin);
+        return true;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Consume a character if it is next, after any whitespace.
+    /// \param  character   the character to consume.
+    /// \return true if the character was consumed, false otherwise.
+    bool consume(const char& character) {
+        skipSpace();
+        if (m_pos < m_text.size() && m_text[m_pos] == character) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Skip past any whitespace.
+    void skipSpace() noexcept {
+        while (m_pos < m_text.size() &&
+               std::isspace(static_cast<unsigned char>(m_text[m_pos])) != 0)
+            ++m_pos;
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Record the first failure and where it happened.
+    /// \param  message the description of the failure.
+    /// \return false.
+    bool fail(const std::string& message) {
+        if (m_error.empty())
+            m_error = message + " at offset " + std::to_string(m_pos);
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    const std::string& m_text; ///< The text being parsed.
+    size_t m_pos = 0ULL;       ///< The offset of the next character.
+    std::string m_error;       ///< The first failure, if any.
+};
+
+//////////////////////////////////////////////////////////////////////
+/// loadBaseline
+//////////////////////////////////////////////////////////////////////
+
+std::optional<Baseline>
+loadBaseline(const std::string& path, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "can't open " + path;
+        return {};
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    return BaselineParser(text.str()).parse(error);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// saveBaseline
+//////////////////////////////////////////////////////////////////////
+
+bool saveBaseline(const std::string& path, const Baseline& baseline) {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+    file << std::fixed << std::setprecision(2) << "{\n";
+    size_t index = 0ULL;
+    for (const auto& [name, entry] : baseline) {
+        file << "    \"" << name << "\": {\n"
+             << "        \"stepMicroseconds\": " << entry.stepMicroseconds
+             << ",\n"
+             << "        \"timeTolerance\": " << entry.timeTolerance << ",\n"
+             << "        \"allocationsPerStep\": " << entry.allocationsPerStep
+             << ",\n"
+             << "        \"allocationTolerance\": "
+             << entry.allocationTolerance << "\n"
+             << "    }" << (++index < baseline.size() ? "," : "") << "\n";
+    }
+    file << "}\n";
+    return static_cast<bool>(file);
+}
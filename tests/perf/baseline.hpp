@@ -0,0 +1,40 @@
+#pragma once
+#ifndef BASELINE_HPP
+#define BASELINE_HPP
+
+#include <map>
+#include <optional>
+#include <string>
+
+/////////////////////////////////////////////////////////////////////////
+/// \struct BaselineEntry
+/// \brief  The expected cost of a perf scenario, and how far it may drift.
+struct BaselineEntry {
+    double stepMicroseconds = 0.0;    ///< Median time per step.
+    double timeTolerance = 0.5;       ///< Allowed relative slowdown.
+    double allocationsPerStep = 0.0;  ///< Mean heap allocations per step.
+    double allocationTolerance = 0.0; ///< Allowed extra allocations per step.
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Baseline entries, by scenario name.
+using Baseline = std::map<std::string, BaselineEntry>;
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Read a baseline from a JSON file.
+///         The file holds one object per scenario, each mapping the fields
+///         of BaselineEntry to numbers; missing fields keep their defaults.
+/// \param  path    the path to the JSON file.
+/// \param  error   set to a description of the problem on failure.
+/// \return the baseline, or nothing if the file can't be read or parsed.
+std::optional<Baseline>
+loadBaseline(const std::string& path, std::string& error);
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Write a baseline to a JSON file, sorted by scenario name.
+/// \param  path        the path to the JSON file.
+/// \param  baseline    the baseline to write.
+/// \return true on success, false otherwise.
+bool saveBaseline(const std::string& path, const Baseline& baseline);
+
+#endif // BASELINE_HPP
@@ -0,0 +1,262 @@
+#include "baseline.hpp"
+#include "renderSystem.hpp"
+#include "scenario.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+/// Workers every scenario runs with, whatever the machine's core count, as
+/// the number of tasks queued, and so allocated, depends on it
+constexpr size_t gateThreads = 3ULL;
+//////////////////////////////////////////////////////////////////////
+/// Heap allocations made by every thread, counted by operator new
+static std::atomic<size_t> g_allocations{ 0ULL };
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1ULL, std::memory_order_relaxed);
+    if (auto* memory = std::malloc(size == 0ULL ? 1ULL : size))
+        return memory;
+    throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t /*size*/) noexcept {
+    std::free(memory);
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \struct Measurement
+/// \brief  The measured cost of a perf scenario.
+struct Measurement {
+    double stepMicroseconds = 0.0;   ///< Median time per step.
+    double allocationsPerStep = 0.0; ///< Mean heap allocations per step.
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// \struct PerfScenario
+/// \brief  A named, deterministic workload to measure.
+struct PerfScenario {
+    std::string name;                 ///< Name of the baseline entry.
+    std::function<Measurement()> run; ///< Sets up and measures the workload.
+};
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Time a number of steps, after some untimed warm-up steps.
+/// \param  warmupSteps     the number of untimed steps.
+/// \param  steps           the number of timed steps.
+/// \param  step            function running a single step, given its number.
+/// \return the median step time and mean allocations per timed step.
+template <typename Func>
+static Measurement
+measure(const size_t& warmupSteps, const size_t& steps, Func&& step) {
+    for (size_t index = 0ULL; index < warmupSteps; ++index)
+        step(index);
+
+    std::vector<double> times(steps);
+    const auto allocationsBefore = g_allocations.load();
+    for (size_t index = 0ULL; index < steps; ++index) {
+        const auto start = std::chrono::steady_clock::now();
+        step(warmupSteps + index);
+        const std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+        times[index] = elapsed.count();
+    }
+    const auto allocations = g_allocations.load() - allocationsBefore;
+
+    std::nth_element(times.begin(), times.begin() + steps / 2, times.end());
+    return Measurement{ times[steps / 2], static_cast<double>(allocations) /
+                                              static_cast<double>(steps) };
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Measure collision steps from a canned grid.
+/// \param  scenario    the particles to simulate.
+/// \param  mode        the collision system's rule set.
+/// \param  warmupSteps the number of untimed steps, letting piles settle.
+/// \param  steps       the number of timed steps.
+/// \return the measured cost.
+static Measurement measureCollision(
+    Scenario scenario, const CollisionSystem::Mode& mode,
+    const size_t& warmupSteps, const size_t& steps) {
+    scenario.linkComponents();
+    CollisionFixture fixture(gateThreads);
+    fixture.m_collision.setMode(mode);
+    return measure(warmupSteps, steps, [&](const size_t& step) {
+        fixture.m_rng.setStep(step + 1ULL);
+        fixture.m_collision.updateComponents(0.025, scenario.m_components);
+    });
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Retrieve every perf scenario.
+/// \return the perf scenarios.
+static std::vector<PerfScenario> makeScenarios() {
+    using Mode = CollisionSystem::Mode;
+    return {
+        { "falling_cellular",
+          [] {
+              return measureCollision(
+                  makeFallingScenario(32768ULL, 0.5F), Mode::CELLULAR, 4ULL,
+                  120ULL);
+          } },
+        { "falling_margolus",
+          [] {
+              return measureCollision(
+                  makeFallingScenario(32768ULL, 0.5F), Mode::MARGOLUS, 4ULL,
+                  120ULL);
+          } },
+        { "settled_cellular",
+          [] {
+              return measureCollision(
+                  makeFallingScenario(131072ULL, 1.0F), Mode::CELLULAR, 600ULL,
+                  60ULL);
+          } },
+        { "pack_particles",
+          [] {
+              const auto scenario = makeFallingScenario(131072ULL, 1.0F);
+              std::vector<GPU_Particle> particles;
+              return measure(4ULL, 60ULL, [&](const size_t& /*step*/) {
+                  RenderSystem::packParticles(scenario.m_components, particles);
+              });
+          } },
+    };
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \brief  Compare a measurement against its baseline, printing a table.
+/// \param  name        the scenario's name.
+/// \param  entry       the scenario's baseline.
+/// \param  measured    the scenario's measured cost.
+/// \param  timed       true to gate the step time as well as allocations.
+/// \return true if no gated metric regressed past its tolerance.
+static bool compare(
+    const std::string& name, const BaselineEntry& entry,
+    const Measurement& measured, const bool& timed) {
+#ifdef DEBUG
+    // Unoptimized timings say nothing about the baseline
+    constexpr bool optimized = false;
+#else
+    constexpr bool optimized = true;
+#endif
+    const bool checkTime = optimized && timed;
+    const auto timeLimit = entry.stepMicroseconds * (1.0 + entry.timeTolerance);
+    const auto allocationLimit =
+        entry.allocationsPerStep + entry.allocationTolerance;
+    const bool timeOk = !checkTime || measured.stepMicroseconds <= timeLimit;
+    const bool allocationsOk = measured.allocationsPerStep <= allocationLimit;
+
+    std::printf(
+        "%s\n  %-20s %12s %12s %9s %12s\n", name.c_str(), "metric",
+        "baseline", "measured", "change", "limit");
+    const auto printRow = [](const char* metric, const double& baseline,
+                             const double& value, const double& limit,
+                             const char* verdict) {
+        const auto change =
+            baseline > 0.0 ? (value - baseline) / baseline * 100.0 : 0.0;
+        std::printf(
+            "  %-20s %12.2f %12.2f %+8.1f%% %12.2f  %s\n", metric, baseline,
+            value, change, limit, verdict);
+    };
+    printRow(
+        "stepMicroseconds", entry.stepMicroseconds, measured.stepMicroseconds,
+        timeLimit, !checkTime ? "skipped" : timeOk ? "ok" : "FAIL");
+    printRow(
+        "allocationsPerStep", entry.allocationsPerStep,
+        measured.allocationsPerStep, allocationLimit,
+        allocationsOk ? "ok" : "FAIL");
+    return timeOk && allocationsOk;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// main
+//////////////////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[]) {
+    // Usage: particules_perfgate <baseline.json> [--scenario name] [--time]
+    //                                             [--update]
+    // Step times only hold on the machine that recorded them, so they're
+    // gated on request, allocations always are
+    if (argc < 2) {
+        std::printf(
+            "usage: %s <baseline.json> [--scenario name] [--time] "
+            "[--update]\n",
+            argv[0]);
+        return EXIT_FAILURE;
+    }
+    const std::string baselinePath(argv[1]);
+    std::string onlyScenario;
+    bool update = false;
+    bool timed = false;
+    for (int index = 2; index < argc; ++index) {
+        const std::string argument(argv[index]);
+        if (argument == "--update")
+            update = true;
+        else if (argument == "--time")
+            timed = true;
+        else if (argument == "--scenario" && index + 1 < argc)
+            onlyScenario = argv[++index];
+        else {
+            std::printf("unknown argument %s\n", argument.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Start from the stored baseline, a missing file only fine when updating
+    std::string error;
+    auto baseline = loadBaseline(baselinePath, error);
+    if (!baseline) {
+        if (!update) {
+            std::printf("failed to load baseline: %s\n", error.c_str());
+            return EXIT_FAILURE;
+        }
+        baseline = Baseline{};
+    }
+
+    bool passed = true;
+    bool found = false;
+    for (const auto& scenario : makeScenarios()) {
+        if (!onlyScenario.empty() && scenario.name != onlyScenario)
+            continue;
+        found = true;
+        const auto measured = scenario.run();
+
+        // Record the new measurement, keeping the tolerances
+        if (update) {
+            auto& entry = (*baseline)[scenario.name];
+            entry.stepMicroseconds = measured.stepMicroseconds;
+            entry.allocationsPerStep = measured.allocationsPerStep;
+            std::printf(
+                "%s: %.2f us/step, %.2f allocations/step\n",
+                scenario.name.c_str(), measured.stepMicroseconds,
+                measured.allocationsPerStep);
+            continue;
+        }
+
+        const auto entry = baseline->find(scenario.name);
+        if (entry == baseline->end()) {
+            std::printf(
+                "%s has no baseline, rerun with --update to record one\n",
+                scenario.name.c_str());
+            passed = false;
+            continue;
+        }
+        passed = compare(scenario.name, entry->second, measured, timed) &&
+                 passed;
+    }
+    if (!found) {
+        std::printf("no scenario named %s\n", onlyScenario.c_str());
+        return EXIT_FAILURE;
+    }
+
+    if (update && !saveBaseline(baselinePath, *baseline)) {
+        std::printf("failed to write %s\n", baselinePath.c_str());
+        return EXIT_FAILURE;
+    }
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,264 @@
+#pragma once
+#ifndef SCENARIO_HPP
+#define SCENARIO_HPP
+
+#include "bitboard.hpp"
+#include "collisionSystem.hpp"
+#include "componentView.hpp"
+#include "components.hpp"
+#include "counterRNG.hpp"
+#include "ecsWorld.hpp"
+#include "guardBand.hpp"
+#include "ignitionSystem.hpp"
+#include "materials.hpp"
+#include "reactionSystem.hpp"
+#include "staticLayer.hpp"
+#include "threadPool.hpp"
+#include "timerWheel.hpp"
+#include "worldBuilder.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////
+/// Use the shared mini namespace
+using namespace mini;
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  Scenario
+/// \brief  A canned set of particles, laid out without an ecsWorld.
+///         Built from a seed, so every run starts from identical grids.
+struct Scenario {
+    std::vector<ParticleComponent> m_particles; ///< Every particle.
+    std::vector<std::vector<ecsBaseComponent*>>
+        m_components; ///< Per-entity component lists, as systems take them.
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Point the component lists at the current particles.
+    ///         Each list also holds an empty OnFireComponent slot, for the
+    ///         systems taking it optionally. Must be called again whenever
+    ///         the particles reallocate.
+    void linkComponents() {
+        m_components.clear();
+        m_components.reserve(m_particles.size());
+        for (auto& particle : m_particles)
+            m_components.emplace_back(
+                std::vector<ecsBaseComponent*>{ &particle, nullptr });
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Build a falling particle of a material, from the preset the
+///         engine's world builder uses.
+/// \param  material    the particle's material, one with gravity.
+/// \param  x           the particle's column.
+/// \param  y           the particle's row.
+/// \return the particle.
+inline ParticleComponent
+makeParticle(const Material& material, const int& x, const int& y) {
+    auto particle = makePreset(material).particle;
+    particle.m_pos = vec2(static_cast<float>(x), static_cast<float>(y));
+    return particle;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Fill the play area's rows from the top down, for a grid walled
+///         by its guard band, each cell taken with the chance given.
+/// \tparam Pick        function mapping a uniform number to a material.
+/// \param  count       the number of falling particles, capped by the grid.
+/// \param  fillRatio   the chance of each cell in the filled rows being used.
+/// \param  seed        the seed laying out the particles.
+/// \param  pick        picks the material of each particle.
+/// \return the scenario's particles.
+template <typename Pick>
+Scenario fillScenario(
+    const size_t& count, const float& fillRatio, const std::uint64_t& seed,
+    Pick&& pick) {
+    Scenario scenario;
+    scenario.m_particles.reserve(count);
+
+    // Falling particles, from the top row down
+    const CounterRNG rng(seed);
+    const auto ratio = std::clamp(fillRatio, 0.01F, 1.0F);
+    size_t placed = 0ULL;
+    for (int y = playMax; y >= playMin && placed < count; --y) {
+        for (int x = playMin; x <= playMax && placed < count; ++x) {
+            if (rng.uniform(x, y, 0U) >= ratio)
+                continue;
+            scenario.m_particles.push_back(
+                makeParticle(pick(rng.uniform(x, y, 1U)), x, y));
+            ++placed;
+        }
+    }
+    scenario.linkComponents();
+    return scenario;
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Build a mix of falling particles, as 60% sand, 20% gunpowder and
+///         20% oil.
+/// \param  count       the number of falling particles, capped by the grid.
+/// \param  fillRatio   the chance of each cell in the filled rows being used.
+/// \param  seed        the seed laying out the particles.
+/// \return the scenario's particles.
+inline Scenario makeFallingScenario(
+    const size_t& count, const float& fillRatio,
+    const std::uint64_t& seed = 0ULL) {
+    return fillScenario(count, fillRatio, seed, [](const float& kind) {
+        if (kind < 0.6F)
+            return Material::SAND;
+        return kind < 0.8F ? Material::GUNPOWDER : Material::OIL;
+    });
+}
+
+///////////////////////////////////////////////////////////////////////////
+/// \brief  Build the engine's mix of falling particles, an even split of
+///         sand, oil, gunpowder and gasoline, so both powders and liquids
+///         move each step.
+/// \param  count       the number of falling particles, capped by the grid.
+/// \param  fillRatio   the chance of each cell in the filled rows being used.
+/// \param  seed        the seed laying out the particles.
+/// \return the scenario's particles.
+inline Scenario makeMixedScenario(
+    const size_t& count, const float& fillRatio,
+    const std::uint64_t& seed = 0ULL) {
+    constexpr std::array<Material, 4> materials{
+        Material::SAND, Material::OIL, Material::GUNPOWDER, Material::GASOLINE
+    };
+    return fillScenario(count, fillRatio, seed, [&](const float& kind) {
+        return materials[std::min(
+            static_cast<size_t>(kind * 4.0F), materials.size() - 1)];
+    });
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \struct CollisionFixture
+/// \brief  The grids and systems a collision step needs, minus the ECS.
+///         Starts with the guard band's concrete walls in place.
+struct CollisionFixture {
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct the grids, walled by concrete.
+    /// \param  threadCount the number of workers running the passes.
+    explicit CollisionFixture(
+        const size_t& threadCount = ThreadPool::defaultThreadCount())
+        : m_threadPool(threadCount) {
+        m_staticLayer.addGuardBand(makePreset(Material::CONCRETE).particle);
+    }
+
+    ecsWorld m_world; ///< Unused by the collision system's update.
+    std::shared_ptr<ParticleComponent* [513][513]> m_particleArray =
+        std::shared_ptr<ParticleComponent* [513][513]>(
+            new ParticleComponent*[513][513]()); ///< Array of particles.
+    OccupancyGrid m_occupancy; ///< Bits marking occupied particle cells.
+    StaticLayer m_staticLayer{ m_particleArray,
+                               m_occupancy }; ///< Cells left in place.
+    ThreadPool m_threadPool;                  ///< Threads for the passes.
+    CounterRNG m_rng;                         ///< Deterministic random numbers.
+    CollisionSystem m_collision{
+        m_world,       m_particleArray, m_occupancy,
+        m_staticLayer, m_threadPool,    m_rng }; ///< System under test.
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// \class  GridLinker
+/// \brief  System pointing each particle's cell at it, as the collision
+///         system's rebuild does, without moving anything.
+class GridLinker final : public ecsSystem {
+    public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct a grid linker.
+    /// \param  particleArray   structure identifying particles spatially.
+    explicit GridLinker(
+        std::shared_ptr<ParticleComponent* [513][513]>& particleArray)
+        : m_particleArray(particleArray) {
+        addComponentType(
+            ParticleComponent::Runtime_ID, RequirementsFlag::REQUIRED);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Point the cells at their particles.
+    /// \param	deltaTime	    the amount of time passed since last update.
+    /// \param	components	    the components to update.
+    void updateComponents(
+        const double& /*deltaTime*/,
+        const std::vector<std::vector<ecsBaseComponent*>>& entityComponents)
+        final {
+        for (const auto [particleComponent] :
+             ComponentView<ParticleComponent>(entityComponents))
+            m_particleArray[static_cast<int>(particleComponent.m_pos.y())]
+                           [static_cast<int>(particleComponent.m_pos.x())] =
+                               &particleComponent;
+    }
+
+    private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// Private Members
+    std::shared_ptr<ParticleComponent* [513][513]>& m_particleArray;
+};
+
+/////////////////////////////////////////////////////////////////////////
+/// \struct ReactionFixture
+/// \brief  The world, grids and systems a reaction step needs. Particles
+///         are built into the world and left where they were placed.
+///         Starts with the guard band's concrete walls in place.
+struct ReactionFixture {
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Construct the grids, walled by concrete.
+    /// \param  threadCount the number of workers scanning bands of rows.
+    explicit ReactionFixture(
+        const size_t& threadCount = ThreadPool::defaultThreadCount())
+        : m_threadPool(threadCount) {
+        m_staticLayer.addGuardBand(makePreset(Material::CONCRETE).particle);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Build particles into the world, linking them into the grid.
+    /// \param  descriptors the particles to build.
+    void build(const std::vector<ParticleDescriptor>& descriptors) {
+        m_builder.build(descriptors);
+        m_world.updateSystem(m_linker, 0.0);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Set the flammable particle of a cell on fire.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row, which must hold a flammable particle.
+    void ignite(const int& x, const int& y) {
+        auto& particle = *m_particleArray[y][x];
+        const auto entity = m_world.getEntity(particle.m_entityHandle);
+        const auto flammable = static_cast<FlammableComponent*>(
+            m_world.getComponent<FlammableComponent>(*entity));
+        m_igniter.ignite(*entity, particle, *flammable, 0.025);
+    }
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief  Retrieve the particle of a cell.
+    /// \param  x   the cell's column.
+    /// \param  y   the cell's row, which must be occupied.
+    /// \return reference to the cell's particle.
+    [[nodiscard]] const ParticleComponent&
+    at(const int& x, const int& y) const noexcept {
+        return *m_particleArray[y][x];
+    }
+
+    ecsWorld m_world; ///< Holds the particles reacting.
+    std::shared_ptr<ParticleComponent* [513][513]> m_particleArray =
+        std::shared_ptr<ParticleComponent* [513][513]>(
+            new ParticleComponent*[513][513]()); ///< Array of particles.
+    OccupancyGrid m_occupancy; ///< Bits marking occupied particle cells.
+    StaticLayer m_staticLayer{ m_particleArray,
+                               m_occupancy }; ///< Cells left in place.
+    TimerWheel<FireTimer> m_burnTimers;       ///< When fires burn out.
+    TimerWheel<FireTimer> m_fuseTimers;       ///< When explosives detonate.
+    ThreadPool m_threadPool;                  ///< Threads for the bands.
+    WorldBuilder m_builder{ m_world, m_occupancy,
+                            m_staticLayer }; ///< Places new particles.
+    GridLinker m_linker{ m_particleArray };  ///< Links particles in place.
+    IgnitionSystem m_igniter{ m_world, m_burnTimers,
+                              m_fuseTimers }; ///< Sets particles on fire.
+    ReactionSystem m_reactions{
+        m_world,       m_particleArray, m_occupancy,
+        m_staticLayer, m_igniter,       m_threadPool }; ///< System under test.
+};
+
+#endif // SCENARIO_HPP